@@ -0,0 +1,149 @@
+/*************************************************************
+ * File:	i2c.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Interrupt driven I2C master.  A transfer is
+ * 	submitted with i2cWrite(), i2cRead() or i2cWriteRead(),
+ * 	which return as soon as the START is queued.  The rest of
+ * 	the transfer runs from interrupts.  When it ends the
+ * 	optional callback is run from interrupt context with the
+ * 	final status, and the CPU is woken.  i2cStatus() can be
+ * 	polled instead.  A transfer ends once its STOP is off the
+ * 	bus, so the callback may start the next one.
+ *
+ * 	Two backends share this interface, picked with
+ * 	I2C_BACKEND in i2c_config.h:
+ * 	I2C_USCI	- USCI_B0 on P1.6 (SCL) and P1.7 (SDA),
+ * 				  Timer_A0 CCR0 polls for the end of START
+ * 				  and STOP.  See i2c_usci.c.
+ * 	I2C_BITBANG	- any two P1 pins, one half bit per Timer_A0
+ * 				  CCR0 interrupt.  See i2c_bb.c.
+ *
+ * 	Both backends honour slave clock stretching: USCI_B0 in
+ * 	hardware, the bit-bang engine by reading SCL back after
+ * 	every release.  The bit-bang engine gives up with
+ * 	I2C_TIMEOUT after I2C_STRETCH_US.
+ *
+ * 	The buffer passed in belongs to the driver until the
+ * 	transfer ends.  Both backends run from SMCLK, so callers
+ * 	must not sleep deeper than LPM0 while a transfer is in
+ * 	flight.
+ *
+ * 	A slave left mid-byte by a reset or a glitch can hold
+ * 	SDA low forever.  i2cBusClear() clocks SCL until it lets
+ * 	go (at most 9 pulses) and sends a STOP.  See i2c_clear.c.
+ *
+ * 	Each lab provides an i2c_config.h on its include path.
+ ************************************************************/
+
+#ifndef I2C_H_
+#define I2C_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include "i2c_config.h"
+
+// Backends
+#define I2C_USCI		0
+#define I2C_BITBANG		1
+#ifndef I2C_BACKEND
+#define I2C_BACKEND		I2C_USCI
+#endif
+
+// Bit-bang pins on P1, overridable in i2c_config.h
+#ifndef I2C_BB_SDA
+#define I2C_BB_SDA		BIT7
+#endif
+#ifndef I2C_BB_SCL
+#define I2C_BB_SCL		BIT6
+#endif
+// Pins the selected backend drives
+#if I2C_BACKEND == I2C_USCI
+#define I2C_SCL_PIN		BIT6
+#define I2C_SDA_PIN		BIT7
+#else
+#define I2C_SCL_PIN		I2C_BB_SCL
+#define I2C_SDA_PIN		I2C_BB_SDA
+#endif
+
+/* Longest step through i2cStep(), interrupt accept to reti,
+ * in MCLK cycles.  Counted by hand from the instruction
+ * timings in the family user's guide for the worst path: a
+ * write's ACK clock that loads the next byte and drives its
+ * first bit.
+ * 	accept 6, save R11-R15 15, stretch check 28,
+ * 	switch 10, ACK and next byte 69, bbClockLow() 43,
+ * 	CCR0 reload 11, restore 10, reti 5	= 197
+ * rounded up to 200.  Check it against the listing when
+ * the compiler or its options change.
+ * Steps that end a transfer also run the callback; nothing
+ * is timed after them, so they are left out.  Every SCL
+ * phase must outlast the step that starts it, so a bit
+ * needs at least twice this: I2C_SPEED up to 20 kHz at
+ * 8 MHz, 40 kHz at 16 MHz.
+ */
+#ifndef I2C_BB_ISR_CYCLES
+#define I2C_BB_ISR_CYCLES	200
+#endif
+
+// Bus rates
+#define I2C_STANDARD	100000UL	// standard mode
+#define I2C_FAST		400000UL	// fast mode
+#define I2C_FAST_PLUS	1000000UL	// fast mode plus, slave must allow it
+
+/* Bus timing.  MCLK_HZ declares the MCLK the lab runs at;
+ * both backends clock from SMCLK = MCLK.  I2C_SPEED is the
+ * SCL rate, normally one of the rates above.  Every divider
+ * is worked out from these at compile time, and a rate the
+ * backend cannot reach from MCLK_HZ fails the build.
+ */
+#ifndef MCLK_HZ
+#error "i2c_config.h must declare MCLK_HZ"
+#endif
+#ifndef I2C_SPEED
+#define I2C_SPEED		I2C_STANDARD
+#endif
+
+// Minimum SCL low/high times from the I2C spec for I2C_SPEED
+#if I2C_SPEED <= I2C_STANDARD
+#define I2C_TLOW_NS		4700
+#define I2C_THIGH_NS	4000
+#elif I2C_SPEED <= I2C_FAST
+#define I2C_TLOW_NS		1300
+#define I2C_THIGH_NS	600
+#elif I2C_SPEED <= I2C_FAST_PLUS
+#define I2C_TLOW_NS		500
+#define I2C_THIGH_NS	260
+#else
+#error "I2C_SPEED is above fast mode plus"
+#endif
+
+// Longest a slave may stretch SCL before the transfer is
+// abandoned with I2C_TIMEOUT, the SMBus limit by default
+#ifndef I2C_STRETCH_US
+#define I2C_STRETCH_US	25000UL
+#endif
+
+// MCLK cycles covering ns nanoseconds, rounded up
+#define I2C_NS_CYCLES(ns)	(((ns) * (MCLK_HZ / 1000UL) + 999999UL) / 1000000UL)
+
+// Transfer status
+#define I2C_IDLE		0		// no transfer since reset
+#define I2C_BUSY		1		// transfer in flight
+#define I2C_DONE		2		// last transfer completed
+#define I2C_NACK		3		// slave did not acknowledge
+#define I2C_TIMEOUT		4		// slave held SCL low past I2C_STRETCH_US
+
+typedef void (*i2cCallback)(uint8_t status);
+
+// Function prototypes
+void initI2C();
+int i2cWrite(uint8_t addr, const uint8_t *buf, uint8_t len, i2cCallback done);
+int i2cRead(uint8_t addr, uint8_t *buf, uint8_t len, i2cCallback done);
+int i2cWriteRead(uint8_t addr, const uint8_t *tx, uint8_t txLen,
+		uint8_t *rx, uint8_t rxLen, i2cCallback done);
+uint8_t i2cStatus();
+int i2cBusClear();
+uint16_t i2cBusClears();
+
+#endif /* I2C_H_ */
@@ -0,0 +1,367 @@
+/*************************************************************
+ * File:	i2c_bb.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Bit-banged I2C master on any two P1 pins.
+ * 	See i2c.h.
+ *
+ * 	Timer_A0 CCR0 interrupts once per SCL phase and the
+ * 	engine moves the bus one step per interrupt, so the CPU
+ * 	is free between edges.  Each step reloads CCR0 with the
+ * 	length of the phase it just started.  The pins are driven
+ * 	open drain: P1OUT is held low and a line is pulled low by
+ * 	making it an output, or released to the external pull-up
+ * 	by making it an input.
+ *
+ * 	Every step that follows a release of SCL first reads the
+ * 	line back.  A slave holding it low is stretching the
+ * 	clock: the engine waits for SCL to rise and then gives it
+ * 	a full high phase before going on.
+ ************************************************************/
+
+#include "i2c.h"
+
+#if I2C_BACKEND == I2C_BITBANG
+
+/* SCL timing in MCLK cycles.  The high phase gets its spec
+ * minimum (or the ISR budget if that is longer) and the low
+ * phase gets the rest of the bit period.  START hold and
+ * STOP setup use the high time, bus free uses the low time.
+ */
+#define I2C_BB_PERIOD	((MCLK_HZ + I2C_SPEED - 1) / I2C_SPEED)
+#if I2C_NS_CYCLES(I2C_THIGH_NS) > I2C_BB_ISR_CYCLES
+#define I2C_BB_HIGH		I2C_NS_CYCLES(I2C_THIGH_NS)
+#else
+#define I2C_BB_HIGH		I2C_BB_ISR_CYCLES
+#endif
+#define I2C_BB_LOW		(I2C_BB_PERIOD - I2C_BB_HIGH)
+
+#if I2C_BB_PERIOD <= I2C_BB_HIGH
+#error "I2C_SPEED is out of reach: SCL high time fills the whole bit at MCLK_HZ"
+#endif
+#if I2C_BB_LOW < I2C_NS_CYCLES(I2C_TLOW_NS)
+#error "I2C_SPEED is out of reach: SCL low time is below spec at MCLK_HZ"
+#endif
+#if I2C_BB_LOW < I2C_BB_ISR_CYCLES
+#error "I2C_SPEED is out of reach: SCL low time is shorter than the ISR at MCLK_HZ"
+#endif
+#if I2C_BB_LOW > 0xFFFF
+#error "I2C_SPEED is too slow for Timer_A0 at MCLK_HZ"
+#endif
+
+// High phases to wait on a stretching slave before giving up
+#define I2C_BB_STRETCH	(I2C_STRETCH_US * (MCLK_HZ / 1000000UL) / I2C_BB_HIGH)
+#if I2C_BB_STRETCH > 0xFFFF
+#error "I2C_STRETCH_US is too long for MCLK_HZ"
+#endif
+
+#define SDA_LOW()		(P1DIR |= I2C_BB_SDA)
+#define SDA_HIGH()		(P1DIR &=~ I2C_BB_SDA)
+#define SCL_LOW()		(P1DIR |= I2C_BB_SCL)
+#define SCL_HIGH()		(P1DIR &=~ I2C_BB_SCL)
+#define SDA_IN()		(P1IN & I2C_BB_SDA)
+#define SCL_IN()		(P1IN & I2C_BB_SCL)
+
+// Engine states, one step per timer interrupt
+#define BB_IDLE			0
+#define BB_START		1		// bus idle: pull SDA low
+#define BB_FIRST		2		// SCL high after START: first clock low
+#define BB_FALL			3		// SCL high: sample SDA, pull SCL low
+#define BB_RISE			4		// SCL low: release SCL
+#define BB_STOP			5		// SCL and SDA low: release SCL
+#define BB_STOP2		6		// SCL high: release SDA
+#define BB_RESTART		7		// SCL low, SDA released: release SCL
+#define BB_RESTART2		8		// SCL high: pull SDA low for the repeated START
+
+// Module variables
+static const uint8_t *txPtr;
+static uint8_t *rxPtr;
+static volatile uint8_t count = 0;		// bytes left in this phase of the transfer
+static uint8_t rxCount;					// bytes to read after a repeated START
+static uint8_t slaveAddr;
+static volatile uint8_t status = I2C_IDLE;
+static volatile uint8_t state = BB_IDLE;
+static i2cCallback callback;
+static uint8_t shift;					// byte on the wire
+static uint8_t clk;						// clock within the byte, 8 = ACK
+static uint8_t readMode;				// 1 - transfer is a read
+static uint8_t receiving;				// 1 - slave is driving the data bits
+static uint8_t result;					// status reported once STOP is out
+static uint8_t stretched;				// 1 - slave held SCL low this phase
+static uint16_t stretchWait;			// high phases spent waiting on the slave
+
+
+/* bbAddress()
+ * 	Load the address byte for the next START.
+ * @param: read - 1 for address+R, 0 for address+W
+ * @param: len - bytes to move after the address
+ */
+static void bbAddress(uint8_t read, uint8_t len){
+	count = len;
+	readMode = read;
+	receiving = 0;						// address always goes out
+	shift = (slaveAddr << 1) | read;
+	clk = 0;
+} // end bbAddress()
+
+
+/* bbStart()
+ * 	Claim the bus and start the engine.  A write of txLen
+ * 	bytes goes out first, then a read of rxLen bytes behind
+ * 	a repeated START.  Either length may be 0, not both.
+ * @return: 1 if claimed, 0 if a transfer is in flight
+ */
+static int bbStart(uint8_t addr, uint8_t txLen, uint8_t rxLen, i2cCallback done){
+	if(status == I2C_BUSY || (txLen == 0 && rxLen == 0)){
+		return 0;
+	}
+	status = I2C_BUSY;
+	callback = done;
+	slaveAddr = addr;
+	stretched = 0;
+	stretchWait = 0;
+	if(txLen){
+		bbAddress(0, txLen);
+		rxCount = rxLen;
+	}
+	else{
+		bbAddress(1, rxLen);
+		rxCount = 0;
+	}
+	state = BB_START;
+
+	TA0CCR0 = I2C_BB_LOW - 1;			// bus free before START
+	TA0CCTL0 = CCIE;
+	TA0CTL = TASSEL_2 + MC_1 + TACLR;	// SMCLK, upmode
+	return 1;
+} // end bbStart()
+
+
+/* bbClockLow()
+ * 	Pull SCL low and put the next bit on SDA.
+ */
+static void bbClockLow(){
+	SCL_LOW();
+	if(clk < 8){
+		if(receiving){
+			SDA_HIGH();					// slave drives the bit
+		}
+		else{
+			if(shift & 0x80){
+				SDA_HIGH();
+			}
+			else{
+				SDA_LOW();
+			}
+			shift <<= 1;
+		}
+	}
+	else if(!receiving || count == 1){
+		SDA_HIGH();						// slave ACKs, or master NACKs the last byte
+	}
+	else{
+		SDA_LOW();						// master ACK, more to come
+	}
+	state = BB_RISE;
+} // end bbClockLow()
+
+
+/* bbStop()
+ * 	End the transfer with a STOP.  Pulls both lines low; the
+ * 	next two steps release SCL then SDA.
+ */
+static void bbStop(uint8_t res){
+	SCL_LOW();
+	SDA_LOW();
+	result = res;
+	state = BB_STOP;
+} // end bbStop()
+
+
+/* initI2C()
+ * 	Release both lines to the pull-ups.
+ */
+void initI2C(){
+	P1SEL &=~ (I2C_BB_SDA + I2C_BB_SCL);
+	P1SEL2 &=~ (I2C_BB_SDA + I2C_BB_SCL);
+	P1REN &=~ (I2C_BB_SDA + I2C_BB_SCL);
+	P1OUT &=~ (I2C_BB_SDA + I2C_BB_SCL);	// output means low
+	P1DIR &=~ (I2C_BB_SDA + I2C_BB_SCL);	// released
+} // end initI2C()
+
+
+/* i2cWrite()
+ * 	Queue a write transfer.
+ * @param: addr - 7 bit slave address
+ * @param: buf - bytes to send, held until the transfer ends
+ * @param: len - number of bytes
+ * @param: done - called with the final status, may be 0
+ * @return: 1 if queued, 0 if the bus is busy
+ */
+int i2cWrite(uint8_t addr, const uint8_t *buf, uint8_t len, i2cCallback done){
+	txPtr = buf;
+	return bbStart(addr, len, 0, done);
+} // end i2cWrite()
+
+
+/* i2cRead()
+ * 	Queue a read transfer.  The master ACKs every byte but
+ * 	the last, which it NACKs before the STOP.
+ * @param: addr - 7 bit slave address
+ * @param: buf - filled in with the bytes read
+ * @param: len - number of bytes
+ * @param: done - called with the final status, may be 0
+ * @return: 1 if queued, 0 if the bus is busy
+ */
+int i2cRead(uint8_t addr, uint8_t *buf, uint8_t len, i2cCallback done){
+	rxPtr = buf;
+	return bbStart(addr, 0, len, done);
+} // end i2cRead()
+
+
+/* i2cWriteRead()
+ * 	Queue a write followed by a burst read in one transfer,
+ * 	joined by a repeated START so no other master can get
+ * 	in between.  Typically the write sets a register pointer
+ * 	and the read fetches from it.
+ * @param: addr - 7 bit slave address
+ * @param: tx - bytes to send, held until the transfer ends
+ * @param: txLen - number of bytes to send, 0 for a plain read
+ * @param: rx - filled in with the bytes read
+ * @param: rxLen - number of bytes to read, 0 for a plain write
+ * @param: done - called with the final status, may be 0
+ * @return: 1 if queued, 0 if the bus is busy
+ */
+int i2cWriteRead(uint8_t addr, const uint8_t *tx, uint8_t txLen,
+		uint8_t *rx, uint8_t rxLen, i2cCallback done){
+	txPtr = tx;
+	rxPtr = rx;
+	return bbStart(addr, txLen, rxLen, done);
+} // end i2cWriteRead()
+
+
+/* i2cStatus()
+ * @return: status of the last transfer
+ */
+uint8_t i2cStatus(){
+	return status;
+} // end i2cStatus()
+
+
+// Timer A0 interrupt service routine, one SCL phase per call
+#pragma vector=TIMER0_A0_VECTOR
+__interrupt void i2cStep(void){
+	if(state == BB_FALL || state == BB_RESTART2 || state == BB_STOP2){
+		if(!SCL_IN()){
+			// slave is stretching the clock, look again next phase
+			stretched = 1;
+			if(++stretchWait > I2C_BB_STRETCH){
+				SCL_HIGH();
+				SDA_HIGH();
+				TA0CTL = MC_0;
+				TA0CCTL0 = 0;
+				state = BB_IDLE;
+				status = I2C_TIMEOUT;
+				if(callback){
+					callback(I2C_TIMEOUT);
+				}
+				__bic_SR_register_on_exit(LPM4_bits);	// wake main
+				return;
+			}
+			TA0CCR0 = I2C_BB_HIGH - 1;
+			return;
+		}
+		if(stretched){
+			// SCL just rose, the high phase starts now
+			stretched = 0;
+			TA0CCR0 = I2C_BB_HIGH - 1;
+			return;
+		}
+		stretchWait = 0;
+	}
+
+	switch(state){
+	case BB_START:
+		SDA_LOW();						// START: SDA falls while SCL is high
+		state = BB_FIRST;
+		break;
+	case BB_FIRST:
+		bbClockLow();
+		break;
+	case BB_RISE:
+		SCL_HIGH();
+		state = BB_FALL;
+		break;
+	case BB_FALL:
+		if(clk < 8){
+			if(receiving){
+				shift = (shift << 1) | (SDA_IN() ? 1 : 0);
+			}
+			clk++;
+			bbClockLow();
+			break;
+		}
+		// ACK clock done
+		if(!receiving && SDA_IN()){
+			bbStop(I2C_NACK);
+			break;
+		}
+		if(receiving){
+			*rxPtr++ = shift;
+			count--;
+		}
+		receiving = readMode;			// after the address, data flows the transfer's way
+		if(count == 0){
+			if(rxCount){
+				// write phase done, turn the bus around
+				bbAddress(1, rxCount);
+				rxCount = 0;
+				SCL_LOW();
+				SDA_HIGH();
+				state = BB_RESTART;
+				break;
+			}
+			bbStop(I2C_DONE);
+			break;
+		}
+		if(!receiving){
+			shift = *txPtr++;
+			count--;
+		}
+		clk = 0;
+		bbClockLow();
+		break;
+	case BB_RESTART:
+		SCL_HIGH();
+		state = BB_RESTART2;
+		break;
+	case BB_RESTART2:
+		SDA_LOW();						// repeated START: SDA falls while SCL is high
+		state = BB_FIRST;
+		break;
+	case BB_STOP:
+		SCL_HIGH();
+		state = BB_STOP2;
+		break;
+	case BB_STOP2:
+		SDA_HIGH();						// STOP: SDA rises while SCL is high
+		TA0CTL = MC_0;
+		TA0CCTL0 = 0;
+		state = BB_IDLE;
+		status = result;
+		if(callback){
+			callback(result);
+		}
+		__bic_SR_register_on_exit(LPM4_bits);	// wake main
+		return;
+	}
+	// time the phase just started
+	if(P1DIR & I2C_BB_SCL){
+		TA0CCR0 = I2C_BB_LOW - 1;
+	}
+	else{
+		TA0CCR0 = I2C_BB_HIGH - 1;
+	}
+} // end i2cStep()
+
+#endif /* I2C_BACKEND == I2C_BITBANG */
@@ -0,0 +1,86 @@
+/*************************************************************
+ * File:	i2c_clear.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	I2C bus clear, shared by both backends.  See
+ * 	i2c.h.
+ *
+ * 	The pins are taken off the backend and driven open drain
+ * 	by hand, then handed back through initI2C().  This busy
+ * 	waits for up to ten bit times, so it is only worth
+ * 	calling when the bus is known to be stuck.
+ ************************************************************/
+
+#include "i2c.h"
+
+#define I2C_PINS		(I2C_SCL_PIN + I2C_SDA_PIN)
+#define CLR_LOW			I2C_NS_CYCLES(I2C_TLOW_NS)
+#define CLR_HIGH		I2C_NS_CYCLES(I2C_THIGH_NS)
+
+// Module variables
+static uint16_t clears = 0;				// times the bus had to be clocked free
+
+
+/* i2cBusClear()
+ * 	Free a bus held by a slave.  While SDA reads low, pulse
+ * 	SCL up to nine times so the slave can finish the byte it
+ * 	thinks it is sending, then send a STOP to reset every
+ * 	slave's state machine.  Returns at once if both lines
+ * 	already read high.
+ * @return: 1 if both lines read high afterwards, 0 if the
+ * 		bus is still stuck or a transfer or its STOP is in
+ * 		flight
+ */
+int i2cBusClear(){
+	uint8_t i;
+
+	if(i2cStatus() == I2C_BUSY){
+		return 0;
+	}
+#if I2C_BACKEND == I2C_USCI
+	if(UCB0CTL1 & UCTXSTP){
+		return 0;							// our own STOP still going out
+	}
+#endif
+	__delay_cycles(CLR_HIGH);				// a STOP just sent may still be rising
+	if((P1IN & I2C_PINS) == I2C_PINS){
+		return 1;
+	}
+	clears++;
+
+#if I2C_BACKEND == I2C_USCI
+	UCB0CTL1 |= UCSWRST;					// let go of the pins
+#endif
+	P1SEL &=~ I2C_PINS;
+	P1SEL2 &=~ I2C_PINS;
+	P1OUT &=~ I2C_PINS;						// output means low
+	P1DIR &=~ I2C_PINS;						// both released
+
+	for(i = 0; i < 9 && !(P1IN & I2C_SDA_PIN); i++){
+		P1DIR |= I2C_SCL_PIN;
+		__delay_cycles(CLR_LOW);
+		P1DIR &=~ I2C_SCL_PIN;
+		__delay_cycles(CLR_HIGH);
+	}
+
+	// STOP: SDA rises while SCL is high
+	P1DIR |= I2C_SCL_PIN;
+	__delay_cycles(CLR_LOW);
+	P1DIR |= I2C_SDA_PIN;
+	__delay_cycles(CLR_LOW);
+	P1DIR &=~ I2C_SCL_PIN;
+	__delay_cycles(CLR_HIGH);
+	P1DIR &=~ I2C_SDA_PIN;
+	__delay_cycles(CLR_LOW);				// bus free time
+
+	initI2C();
+	return (P1IN & I2C_PINS) == I2C_PINS;
+} // end i2cBusClear()
+
+
+/* i2cBusClears()
+ * @return: times i2cBusClear() found the bus stuck
+ */
+uint16_t i2cBusClears(){
+	return clears;
+} // end i2cBusClears()
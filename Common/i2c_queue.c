@@ -0,0 +1,260 @@
+/*************************************************************
+ * File:	i2c_queue.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	I2C transaction queue.  See i2c_queue.h.
+ ************************************************************/
+
+#include "i2c_queue.h"
+
+#if I2C_QUEUE_LEN & (I2C_QUEUE_LEN - 1)
+#error "I2C_QUEUE_LEN must be a power of two"
+#endif
+#if (I2C_BACKOFF << I2C_RETRIES) > 0xFFFF
+#error "I2C_BACKOFF << I2C_RETRIES must fit Timer_A1"
+#endif
+
+#define NEXT(i)		(((i) + 1) & (I2C_QUEUE_LEN - 1))
+
+// Module variables.  The entry at tail is on the bus while
+// running is set; the rest up to head are waiting.
+static i2cTxn *queue[I2C_QUEUE_LEN];
+static volatile uint8_t head = 0;
+static volatile uint8_t tail = 0;
+static volatile uint8_t running = 0;
+static volatile uint8_t backoff = 0;	// 1 - paused after a failure
+static i2cStats stats[I2C_DEVICES];
+
+
+static void queueDone(uint8_t status);
+
+
+/* queueStart()
+ * 	Put the transaction at tail on the bus.  Runs with
+ * 	interrupts off or from interrupt context.
+ */
+static void queueStart(){
+	i2cTxn *t;
+
+	running = 0;
+	if(tail == head || backoff){
+		return;
+	}
+	t = queue[tail];
+	t->status = I2C_BUSY;
+	if(i2cWriteRead(t->addr, t->tx, t->txLen, t->rx, t->rxLen, queueDone)){
+		running = 1;
+	}
+	else{
+		// someone went round the queue, retried on the next submit
+		t->status = I2C_QUEUED;
+	}
+} // end queueStart()
+
+
+/* queueStats()
+ * 	Find the counters for a device, claiming a free slot the
+ * 	first time it is seen.
+ * @return: counters, 0 if every slot is taken
+ */
+static i2cStats *queueStats(uint8_t addr){
+	uint8_t i;
+
+	for(i = 0; i < I2C_DEVICES; i++){
+		if(stats[i].addr == addr){
+			return &stats[i];
+		}
+		if(stats[i].addr == 0){
+			stats[i].addr = addr;			// 0 is the general call, never a device
+			return &stats[i];
+		}
+	}
+	return 0;
+} // end queueStats()
+
+
+/* queueRetry()
+ * 	Send the failed transaction at tail to the back of the
+ * 	queue and start the backoff.  Interrupt context.
+ */
+static void queueRetry(i2cTxn *t, i2cStats *st){
+	tail = NEXT(tail);
+	queue[head] = t;						// the slot just freed guarantees room
+	head = NEXT(head);
+	t->status = I2C_QUEUED;
+	if(st){
+		st->retries++;
+	}
+
+	backoff = 1;
+	TA1CCR0 = (I2C_BACKOFF << (t->tries - 1)) - 1;
+	TA1CCTL0 = CCIE;
+	TA1CTL = TASSEL_1 + MC_1 + TACLR;		// ACLK, upmode
+} // end queueRetry()
+
+
+/* queueDone()
+ * 	I2C completion callback.  Reports the transaction at tail,
+ * 	or sends it round again if it failed and has tries left,
+ * 	then starts the next one.
+ * @param: status - final I2C status
+ */
+static void queueDone(uint8_t status){
+	i2cTxn *t = queue[tail];
+	i2cStats *st;
+
+	if(status != I2C_DONE){
+		st = queueStats(t->addr);
+		if(st){
+			st->errors++;
+		}
+		if(t->tries < I2C_RETRIES){
+			t->tries++;
+			queueRetry(t, st);
+			running = 0;
+			return;
+		}
+		if(st){
+			st->failures++;
+		}
+	}
+
+	tail = NEXT(tail);
+	running = 0;							// a submit from the callback sees the bus free
+	t->status = status;
+	if(t->done){
+		t->done(status);					// may submit, and so start, more
+	}
+	if(!running){
+		queueStart();
+	}
+} // end queueDone()
+
+
+/* initI2CQueue()
+ * 	Run ACLK from VLO for the backoff timer, empty the queue
+ * 	and free the bus from any slave a reset of ours left
+ * 	mid-byte.
+ */
+void initI2CQueue(){
+	i2cBusClear();
+	BCSCTL3 |= LFXT1S_2;					// ACLK = VLO
+	TA1CTL = MC_0;
+	TA1CCTL0 = 0;
+	head = 0;
+	tail = 0;
+	running = 0;
+	backoff = 0;
+} // end initI2CQueue()
+
+
+/* i2cSubmit()
+ * 	Queue a transaction.  Safe from interrupt context.
+ * @param: t - transaction, owned by the queue until its
+ * 		status leaves I2C_QUEUED/I2C_BUSY
+ * @return: 1 if queued, 0 if the queue is full, t is already
+ * 		on the bus or has nothing to move
+ */
+int i2cSubmit(i2cTxn *t){
+	unsigned short state;
+	i2cTxn *q;
+	uint8_t first, i;
+	int ok = 1;
+
+	if(t->txLen == 0 && t->rxLen == 0){
+		return 0;
+	}
+	state = __get_interrupt_state();
+	__disable_interrupt();
+
+	if(t->status == I2C_BUSY){
+		ok = 0;
+	}
+	else{
+		first = running ? NEXT(tail) : tail;
+		for(i = first; i != head && queue[i] != t; i = NEXT(i));
+		if(i == head){
+			// not waiting yet: take the place of a waiting write
+			// this one supersedes, or join the back
+			for(i = first; i != head; i = NEXT(i)){
+				q = queue[i];
+				if(q->addr == t->addr && q->rxLen == 0 && t->rxLen == 0
+						&& q->tx[0] == t->tx[0] && t->txLen >= q->txLen){
+					queue[i] = t;
+					t->status = I2C_QUEUED;
+					t->tries = 0;
+					q->status = I2C_DROPPED;
+					if(q->done){
+						q->done(I2C_DROPPED);
+					}
+					break;
+				}
+			}
+			if(i == head){
+				if(NEXT(head) == tail){
+					ok = 0;						// full
+				}
+				else{
+					t->status = I2C_QUEUED;
+					t->tries = 0;
+					queue[head] = t;
+					head = NEXT(head);
+				}
+			}
+		}
+		if(!running){
+			queueStart();
+		}
+	}
+
+	__set_interrupt_state(state);
+	return ok;
+} // end i2cSubmit()
+
+
+/* i2cQueueIdle()
+ * @return: 1 if nothing is on the bus or waiting for it
+ */
+uint8_t i2cQueueIdle(){
+	return tail == head;
+} // end i2cQueueIdle()
+
+
+/* i2cQueueClock()
+ * @return: deepest LPM the queue allows, for the scheduler
+ */
+uint16_t i2cQueueClock(){
+	return i2cQueueIdle() ? LPM4_bits : LPM0_bits;
+} // end i2cQueueClock()
+
+
+/* i2cDeviceStats()
+ * @param: addr - 7 bit slave address
+ * @return: error and retry counters for the device, 0 if it
+ * 		has never been seen to fail
+ */
+const i2cStats *i2cDeviceStats(uint8_t addr){
+	uint8_t i;
+
+	for(i = 0; i < I2C_DEVICES; i++){
+		if(stats[i].addr == addr){
+			return &stats[i];
+		}
+	}
+	return 0;
+} // end i2cDeviceStats()
+
+
+// Timer A1 CCR0 interrupt service routine, end of a backoff
+#pragma vector=TIMER1_A0_VECTOR
+__interrupt void i2cBackoff(void){
+	TA1CTL = MC_0;
+	TA1CCTL0 = 0;
+	backoff = 0;
+	// the failed transfer's STOP is long out; a slave still
+	// holding SDA low is stuck mid-byte
+	if(!(P1IN & I2C_SDA_PIN)){
+		i2cBusClear();
+	}
+	queueStart();
+} // end i2cBackoff()
@@ -0,0 +1,90 @@
+/*************************************************************
+ * File:	i2c_queue.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Transaction queue on top of the I2C master, for
+ * 	labs with more than one device on the bus.
+ *
+ * 	A transaction is described by an i2cTxn the caller owns
+ * 	(usually static).  i2cSubmit() queues it and returns; the
+ * 	queue runs transactions back to back from the I2C
+ * 	completion interrupt, so the bus never waits on main.
+ * 	When one ends its status field is set and its callback,
+ * 	if any, is run from interrupt context.
+ *
+ * 	A write submitted while an earlier write to the same
+ * 	device and register (first tx byte) is still waiting
+ * 	takes the earlier one's place, provided it is at least
+ * 	as long.  The earlier one completes with I2C_DROPPED
+ * 	without going out.
+ *
+ * 	A transaction that fails is retried up to I2C_RETRIES
+ * 	times.  After a failure the queue pauses for a backoff
+ * 	timed by Timer_A1 CCR0 from ACLK, doubling with every
+ * 	attempt, and the failed transaction goes to the back so
+ * 	other devices are served first.  Nothing blocks while
+ * 	the queue backs off.  If a slave still holds SDA low when
+ * 	the backoff ends, the bus is cleared before the next
+ * 	transfer; an ordinary NACK never triggers a clear.
+ * 	Errors and retries are counted per device address.
+ *
+ * 	The backoff timer restarts transfers from its interrupt
+ * 	without waking main, so i2cQueueClock() asks the
+ * 	scheduler for SMCLK until the queue is empty.
+ *
+ * 	Once the queue is in use, every transfer on the bus must
+ * 	go through it.  initI2CQueue() must be called after
+ * 	initI2C().
+ ************************************************************/
+
+#ifndef I2C_QUEUE_H_
+#define I2C_QUEUE_H_
+
+#include "i2c.h"
+
+// Queue length, overridable in i2c_config.h
+#ifndef I2C_QUEUE_LEN
+#define I2C_QUEUE_LEN	8		// power of two, holds one less
+#endif
+
+// Retry policy, overridable in i2c_config.h
+#ifndef I2C_RETRIES
+#define I2C_RETRIES		3		// attempts after the first
+#endif
+#ifndef I2C_BACKOFF
+#define I2C_BACKOFF		12		// first backoff in ACLK ticks, ~1 ms from VLO
+#endif
+#ifndef I2C_DEVICES
+#define I2C_DEVICES		4		// addresses with their own counters
+#endif
+
+// Transaction status, on top of the I2C status values
+#define I2C_QUEUED		5		// waiting for the bus
+#define I2C_DROPPED		6		// replaced by a later write to the same register
+
+typedef struct {
+	uint8_t addr;				// 7 bit slave address
+	const uint8_t *tx;			// bytes to send, first is the register
+	uint8_t txLen;				// 0 for a plain read
+	uint8_t *rx;				// filled in with the bytes read
+	uint8_t rxLen;				// 0 for a plain write
+	i2cCallback done;			// run from interrupt context, may be 0
+	volatile uint8_t status;	// I2C_QUEUED, I2C_BUSY, then the final status
+	uint8_t tries;				// failed attempts so far, cleared on submit
+} i2cTxn;
+
+typedef struct {
+	uint8_t addr;				// 7 bit slave address
+	uint16_t errors;			// failed attempts
+	uint16_t retries;			// attempts made after a failure
+	uint16_t failures;			// transactions given up on
+} i2cStats;
+
+// Function prototypes
+void initI2CQueue();
+int i2cSubmit(i2cTxn *t);
+uint8_t i2cQueueIdle();
+uint16_t i2cQueueClock();
+const i2cStats *i2cDeviceStats(uint8_t addr);
+
+#endif /* I2C_QUEUE_H_ */
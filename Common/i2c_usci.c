@@ -0,0 +1,299 @@
+/*************************************************************
+ * File:	i2c_usci.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	USCI_B0 I2C master.  See i2c.h.
+ *
+ * 	In I2C mode UCB0TXIFG and UCB0RXIFG are served by
+ * 	USCIAB0TX_VECTOR; the NACK state change is served by
+ * 	USCIAB0RX_VECTOR.
+ *
+ * 	The USCI raises no interrupt when a master START or STOP
+ * 	finishes, so Timer_A0 CCR0 polls UCTXSTT/UCTXSTP once a
+ * 	bit while one is going out.  A transfer only ends, and
+ * 	its callback only runs, once its STOP is off the bus, so
+ * 	the callback can start the next transfer at once and a
+ * 	NACK of the last byte written is still reported.
+ ************************************************************/
+
+#include "i2c.h"
+
+#if I2C_BACKEND == I2C_USCI
+
+#define I2C_PRESCALE	((MCLK_HZ + I2C_SPEED - 1) / I2C_SPEED)	// never faster than asked
+
+#if I2C_SPEED > I2C_FAST
+#error "USCI_B0 tops out at fast mode, use I2C_FAST or slower"
+#endif
+#if I2C_PRESCALE < 4 || I2C_PRESCALE > 0xFFFF
+#error "I2C_SPEED is out of reach from MCLK_HZ"
+#endif
+
+// START/STOP poll period: one bit, but never shorter than
+// the poll interrupt itself
+#define I2C_POLL_MIN	64
+#if I2C_PRESCALE > I2C_POLL_MIN
+#define I2C_POLL		I2C_PRESCALE
+#else
+#define I2C_POLL		I2C_POLL_MIN
+#endif
+
+// Module variables
+static const uint8_t *txPtr;
+static uint8_t *rxPtr;
+static volatile uint8_t count = 0;			// bytes left in this phase of the transfer
+static uint8_t rxCount;						// bytes to read after a repeated START
+static volatile uint8_t status = I2C_IDLE;
+static i2cCallback callback;
+static uint8_t result;						// status reported once the STOP is out
+static volatile uint8_t stopping = 0;		// 1 - STOP queued, polling for its end
+
+
+/* i2cPoll()
+ * 	Start Timer_A0 polling the USCI: first after bits bit
+ * 	times, then once a bit.
+ * @param: bits - bit times until the first look
+ */
+static void i2cPoll(uint8_t bits){
+	uint32_t first = (uint32_t)bits * I2C_POLL;
+
+	TA0CCR0 = (first > 0x10000 ? 0x10000 : first) - 1;
+	TA0CCTL0 = CCIE;
+	TA0CTL = TASSEL_2 + MC_1 + TACLR;		// SMCLK, upmode
+} // end i2cPoll()
+
+
+/* i2cStop()
+ * 	The STOP is queued; report the transfer once it is out.
+ * 	Interrupt context.
+ * @param: res - final status
+ * @param: bits - bit times the STOP is at least away
+ */
+static void i2cStop(uint8_t res, uint8_t bits){
+	IE2 &=~ (UCB0TXIE + UCB0RXIE);
+	result = res;
+	stopping = 1;
+	i2cPoll(bits);
+} // end i2cStop()
+
+
+/* i2cFinish()
+ * 	End the transfer and report it.  The bus is idle, so the
+ * 	callback may start the next transfer.  Interrupt context.
+ */
+static void i2cFinish(){
+	TA0CTL = MC_0;
+	TA0CCTL0 = 0;
+	stopping = 0;
+	status = result;
+	if(callback){
+		callback(result);
+	}
+} // end i2cFinish()
+
+
+/* i2cStart()
+ * 	Claim the bus for a new transfer.  The last transfer's
+ * 	STOP is already out: status stays I2C_BUSY until it is.
+ * @return: 1 if claimed, 0 if a transfer is in flight
+ */
+static int i2cStart(uint8_t addr, uint8_t len, i2cCallback done){
+	if(status == I2C_BUSY || len == 0){
+		return 0;
+	}
+	status = I2C_BUSY;
+	callback = done;
+	count = len;
+	UCB0I2CSA = addr;
+	return 1;
+} // end i2cStart()
+
+
+/* i2cReadStart()
+ * 	Send START + address+R for a read of count bytes.  Also
+ * 	used from the TX interrupt for the repeated START.
+ */
+static void i2cReadStart(){
+	IE2 |= UCB0RXIE;
+	UCB0CTL1 &=~ UCTR;
+	UCB0CTL1 |= UCTXSTT;						// START + address, read
+	if(count == 1){
+		// A single byte needs its STOP queued once the address
+		// is through, before the byte is clocked in.  The poll
+		// sets it when UCTXSTT clears.
+		i2cPoll(9);
+	}
+} // end i2cReadStart()
+
+
+/* initI2C()
+ * 	Initialize USCI_B0 as a single I2C master at I2C_SPEED.
+ */
+void initI2C(){
+	UCB0CTL1 |= UCSWRST;						// Hold USCI in reset
+	UCB0CTL0 = UCMST + UCMODE_3 + UCSYNC;		// I2C master, synchronous
+	UCB0CTL1 = UCSSEL_2 + UCSWRST;				// SMCLK
+	UCB0BR0 = I2C_PRESCALE & 0xFF;
+	UCB0BR1 = I2C_PRESCALE >> 8;
+	P1SEL |= I2C_SCL_PIN + I2C_SDA_PIN;			// P1.6 = SCL, P1.7 = SDA
+	P1SEL2 |= I2C_SCL_PIN + I2C_SDA_PIN;
+	UCB0CTL1 &=~ UCSWRST;						// **Initialize USCI state machine**
+	UCB0I2CIE |= UCNACKIE;
+	TA0CTL = MC_0;
+	TA0CCTL0 = 0;
+	stopping = 0;
+} // end initI2C()
+
+
+/* i2cWrite()
+ * 	Queue a write transfer.
+ * @param: addr - 7 bit slave address
+ * @param: buf - bytes to send, held until the transfer ends
+ * @param: len - number of bytes
+ * @param: done - called with the final status, may be 0
+ * @return: 1 if queued, 0 if the bus is busy
+ */
+int i2cWrite(uint8_t addr, const uint8_t *buf, uint8_t len, i2cCallback done){
+	return i2cWriteRead(addr, buf, len, 0, 0, done);
+} // end i2cWrite()
+
+
+/* i2cRead()
+ * 	Queue a read transfer.  The master ACKs every byte but
+ * 	the last, which it NACKs before the STOP.
+ * @param: addr - 7 bit slave address
+ * @param: buf - filled in with the bytes read
+ * @param: len - number of bytes
+ * @param: done - called with the final status, may be 0
+ * @return: 1 if queued, 0 if the bus is busy
+ */
+int i2cRead(uint8_t addr, uint8_t *buf, uint8_t len, i2cCallback done){
+	if(!i2cStart(addr, len, done)){
+		return 0;
+	}
+	rxPtr = buf;
+	i2cReadStart();
+	return 1;
+} // end i2cRead()
+
+
+/* i2cWriteRead()
+ * 	Queue a write followed by a burst read in one transfer,
+ * 	joined by a repeated START so no other master can get
+ * 	in between.  Typically the write sets a register pointer
+ * 	and the read fetches from it.
+ * @param: addr - 7 bit slave address
+ * @param: tx - bytes to send, held until the transfer ends
+ * @param: txLen - number of bytes to send, 0 for a plain read
+ * @param: rx - filled in with the bytes read
+ * @param: rxLen - number of bytes to read, 0 for a plain write
+ * @param: done - called with the final status, may be 0
+ * @return: 1 if queued, 0 if the bus is busy
+ */
+int i2cWriteRead(uint8_t addr, const uint8_t *tx, uint8_t txLen,
+		uint8_t *rx, uint8_t rxLen, i2cCallback done){
+	if(txLen == 0){
+		return i2cRead(addr, rx, rxLen, done);
+	}
+	if(!i2cStart(addr, txLen, done)){
+		return 0;
+	}
+	txPtr = tx;
+	rxPtr = rx;
+	rxCount = rxLen;							// picked up once the last byte is loaded
+	IE2 |= UCB0TXIE;
+	UCB0CTL1 |= UCTR + UCTXSTT;					// START + address, write
+	return 1;
+} // end i2cWriteRead()
+
+
+/* i2cStatus()
+ * @return: status of the last transfer
+ */
+uint8_t i2cStatus(){
+	return status;
+} // end i2cStatus()
+
+
+// USCI_B0 data interrupt service routine
+#pragma vector=USCIAB0TX_VECTOR
+__interrupt void i2cData(void){
+	if(IFG2 & UCB0RXIFG){
+		count--;
+		if(count){
+			*rxPtr++ = UCB0RXBUF;
+			if(count == 1){
+				UCB0CTL1 |= UCTXSTP;			// NACK + STOP after the next byte
+			}
+		}
+		else{
+			*rxPtr = UCB0RXBUF;
+			i2cStop(I2C_DONE, 1);
+		}
+	}
+	else if(IFG2 & UCB0TXIFG){
+		if(count){
+			UCB0TXBUF = *txPtr++;
+			count--;
+		}
+		else if(rxCount){
+			// last byte is on the wire, turn the bus around
+			// with a repeated START once it is acknowledged
+			IE2 &=~ UCB0TXIE;
+			IFG2 &=~ UCB0TXIFG;
+			count = rxCount;
+			rxCount = 0;
+			i2cReadStart();
+		}
+		else{
+			// STOP once the last byte is acknowledged.  A NACK
+			// of it still turns the result into I2C_NACK.
+			UCB0CTL1 |= UCTXSTP;
+			IFG2 &=~ UCB0TXIFG;
+			i2cStop(I2C_DONE, 10);
+		}
+	}
+} // end i2cData()
+
+
+// USCI_B0 state interrupt service routine
+#pragma vector=USCIAB0RX_VECTOR
+__interrupt void i2cState(void){
+	if(UCB0STAT & UCNACKIFG){
+		UCB0STAT &=~ UCNACKIFG;
+		if(status != I2C_BUSY){
+			return;								// stale, no transfer to end
+		}
+		if(stopping){
+			result = I2C_NACK;					// last byte refused, STOP already queued
+			return;
+		}
+		UCB0CTL1 |= UCTXSTP;
+		IFG2 &=~ UCB0TXIFG;
+		i2cStop(I2C_NACK, 1);
+	}
+} // end i2cState()
+
+
+// Timer A0 interrupt service routine, once a bit while a
+// START or STOP goes out
+#pragma vector=TIMER0_A0_VECTOR
+__interrupt void i2cPollTick(void){
+	TA0CCR0 = I2C_POLL - 1;
+	if(stopping){
+		if(UCB0CTL1 & UCTXSTP){
+			return;								// still going out
+		}
+		i2cFinish();
+		__bic_SR_register_on_exit(LPM4_bits);	// wake main
+	}
+	else if(!(UCB0CTL1 & UCTXSTT)){
+		// single byte read: address through, NACK + STOP after
+		// the byte
+		UCB0CTL1 |= UCTXSTP;
+		TA0CTL = MC_0;
+		TA0CCTL0 = 0;
+	}
+} // end i2cPollTick()
+
+#endif /* I2C_BACKEND == I2C_USCI */
@@ -0,0 +1,359 @@
+/*************************************************************
+ * File:	keypad.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Shared 4x4 keypad driver.  See keypad.h.
+ ************************************************************/
+
+#include "keypad.h"
+#ifdef KEYPAD_EVENT
+#include "sched.h"
+#endif
+
+#if KEYPAD_DEBOUNCE < 1 || KEYPAD_DEBOUNCE > 8
+#error "KEYPAD_DEBOUNCE must be 1-8 samples"
+#endif
+#if KEYPAD_REPEAT > KEYPAD_HOLD
+#error "KEYPAD_REPEAT must not exceed KEYPAD_HOLD"
+#endif
+#if KEYPAD_COLS != (BIT0 + BIT2 + BIT3 + BIT5)
+#error "colDecode[] assumes columns on P2.0, P2.2, P2.3, P2.5"
+#endif
+#if KEYPAD_QUEUE & (KEYPAD_QUEUE - 1)
+#error "KEYPAD_QUEUE must be a power of two"
+#endif
+
+// Keymap, indexed by key: {1, 2, 3, A}, {4, 5, 6, B}, {7, 8, 9, C}, {*, 0, #, D}
+#if KEYPAD_KEYMAP == KEYMAP_HEX
+const uint8_t keymap[16] = {0x01, 0x02, 0x03, 0x0A,
+							0x04, 0x05, 0x06, 0x0B,
+							0x07, 0x08, 0x09, 0x0C,
+							0x0E, 0x00, 0x0F, 0x0D};
+#elif KEYPAD_KEYMAP == KEYMAP_7SEG
+const uint8_t keymap[16] = {0x30, 0x6D, 0x79, 0x77,
+							0x33, 0x5B, 0x5F, 0x1F,
+							0x70, 0x7F, 0x7B, 0x4E,
+							0x47, 0x7E, 0x4F, 0x3D};
+#elif KEYPAD_KEYMAP == KEYMAP_ASCII
+const uint8_t keymap[16] = {0x31, 0x32, 0x33, 0x41,
+							0x34, 0x35, 0x36, 0x42,
+							0x37, 0x38, 0x39, 0x43,
+							0x00, 0x30, 0x23, 0x44};
+#else
+#error "Unknown KEYPAD_KEYMAP"
+#endif
+
+// Module variables
+static const uint8_t muxRow[] = {0x00, KEYPAD_MUX_LO, KEYPAD_MUX_HI, KEYPAD_MUX};	// Binary: 00, 01, 10, 11
+
+/* Column decode, indexed by COL_INDEX(P2IN).  Each key down
+ * on the driven row pulls its column low: P2.5, P2.3, P2.2,
+ * P2.0 for columns 0-3, which land on index bits 1, 3, 2, 0.
+ * The entry has bit (column * 4) set for every column that
+ * is low:
+ * 	(!b1) << 0 | (!b3) << 4 | (!b2) << 8 | (!b0) << 12
+ * so shifting it left by the row gives that row's keys in
+ * key index order.
+ */
+#define COL_INDEX(in)	(((in) & (BIT0 + BIT2 + BIT3)) | (((in) >> 4) & BIT1))
+static const uint16_t colDecode[16] = {
+	0x1111, 0x0111, 0x1110, 0x0110,		// 0x0 - 0x3
+	0x1011, 0x0011, 0x1010, 0x0010,		// 0x4 - 0x7, 0x25 (P2.3 low) = column 1
+	0x1101, 0x0101, 0x1100, 0x0100,		// 0x8 - 0xB, 0x29 (P2.2 low) = column 2
+	0x1001, 0x0001, 0x1000, 0x0000};	// 0xC - 0xF, 0x0D = column 0, 0x2C = column 3, idle
+static volatile uint8_t parkedRow = 0;	// row driven on the deMUX while parked
+static volatile uint8_t scanning = 0;		// 0 - parked; 1 - sampling every tick
+static volatile uint16_t keypadTicks = 0;	// event timestamp base
+static uint16_t samples[KEYPAD_DEBOUNCE];	// last raw key bitmaps
+static uint8_t sampleIdx = 0;
+static volatile uint16_t keysDown = 0;				// debounced key bitmap
+static uint8_t holdCount[16];				// ticks each key has been down
+
+// Event queue.  The ISRs only move head, main only moves tail.
+static keyEvent queue[KEYPAD_QUEUE];
+static volatile uint8_t head = 0;
+static volatile uint8_t tail = 0;
+static volatile uint8_t dropped = 0;
+
+
+/* keypadScan()
+ * 	Strobe all four rows and read every key on each.
+ *
+ * 	Without diodes, three keys on the corners of a rectangle
+ * 	(two rows sharing two columns) connect the fourth corner
+ * 	too, so it reads down whether or not it is pressed.  Any
+ * 	pair of rows with two or more columns in common is
+ * 	treated as a ghost and the sample is rejected.
+ * @param: raw - filled in with the bitmap of keys down, bit n
+ * 		is key index n
+ * @return: 1 if the sample is good, 0 if it may hold a ghost
+ */
+static int keypadScan(uint16_t *raw){
+	uint16_t rowKeys[4];
+	uint16_t common;
+	uint8_t i, j;
+
+	*raw = 0;
+	for(i = 0; i < 4; i++){
+		P1OUT = (P1OUT & ~KEYPAD_MUX) | muxRow[i];
+		__delay_cycles(KEYPAD_SETTLE);
+		rowKeys[i] = colDecode[COL_INDEX(P2IN)];
+		*raw |= rowKeys[i] << i;
+	}
+
+	if(*raw & (*raw - 1)){
+		// two or more keys down, look for a rectangle
+		for(i = 0; i < 3; i++){
+			for(j = i + 1; j < 4; j++){
+				common = rowKeys[i] & rowKeys[j];
+				if(common & (common - 1)){
+					return 0;
+				}
+			}
+		}
+	}
+	return 1;
+} // end keypadScan()
+
+
+/* keypadPush()
+ * 	Queue an event.  Called from interrupt context only.
+ */
+static void keypadPush(uint8_t key, uint8_t type){
+	uint8_t next = (head + 1) & (KEYPAD_QUEUE - 1);
+	if(next == tail){
+		// main is behind, count the loss
+		if(dropped < 0xFF){
+			dropped++;
+		}
+		return;
+	}
+	queue[head].key = key;
+	queue[head].type = type;
+	queue[head].time = keypadTicks;
+	head = next;							// publish after the event is written
+#ifdef KEYPAD_EVENT
+	schedPost(KEYPAD_EVENT);
+#endif
+} // end keypadPush()
+
+
+/* keypadPark()
+ * 	Stop sampling, park the deMUX and re-arm the edge wake.
+ */
+static void keypadPark(){
+	scanning = 0;
+	parkedRow = 0;
+	P1OUT &=~ KEYPAD_MUX;
+	__delay_cycles(KEYPAD_SETTLE);
+	P2IFG &=~ KEYPAD_COLS;
+	P2IE |= KEYPAD_COLS;
+} // end keypadPark()
+
+
+/* keypadSample()
+ * 	Take one sample of the matrix and advance the debounce.
+ * 	A key is down as soon as one clean sample reads it down,
+ * 	so the sample the edge interrupt takes reports the press
+ * 	at once.  Only the release is debounced: a key is up
+ * 	once it read up for every one of the last
+ * 	KEYPAD_DEBOUNCE samples, so contact bounce while it is
+ * 	down never reads as a release and press.
+ */
+static void keypadSample(){
+	uint16_t any = 0;
+	uint16_t raw, down, changed, bit;
+	uint8_t i;
+
+	if(!keypadScan(&raw)){
+		// ghost, drop the whole sample and hold the debounce
+		return;
+	}
+	samples[sampleIdx] = raw;
+	if(++sampleIdx >= KEYPAD_DEBOUNCE){
+		sampleIdx = 0;
+	}
+	for(i = 0; i < KEYPAD_DEBOUNCE; i++){
+		any |= samples[i];
+	}
+	down = keysDown;
+	changed = down;
+	down = (down & any) | raw;
+	keysDown = down;
+	changed ^= down;
+
+	for(i = 0, bit = 1; i < 16; i++, bit <<= 1){
+		if(changed & bit){
+			holdCount[i] = 0;
+			keypadPush(i, (down & bit) ? KEY_PRESSED : KEY_RELEASED);
+		}
+		else if((down & bit) && ++holdCount[i] >= KEYPAD_HOLD){
+			holdCount[i] = KEYPAD_HOLD - KEYPAD_REPEAT;
+			keypadPush(i, KEY_HELD);
+		}
+	}
+
+	if(!down && !any){
+		// every key released and settled
+		keypadPark();
+	}
+} // end keypadSample()
+
+
+/* initKeypad()
+ * 	Park the deMUX on row 0, arm falling edge interrupts on
+ * 	the column lines and start the WDT tick from VLO.
+ * 	Must be called after the watchdog has been stopped.
+ */
+void initKeypad(){
+	BCSCTL3 |= LFXT1S_2;					// ACLK = VLO
+
+	P1DIR |= KEYPAD_MUX;					// Set as output ports
+
+	P2DIR &=~ KEYPAD_COLS;					// Enable input for keypad
+	P2OUT |= KEYPAD_COLS;					// Pull column lines up
+	P2REN |= KEYPAD_COLS;					// Enable resistors
+	P2IES |= KEYPAD_COLS;					// Key down pulls a column low
+	keypadPark();
+
+	WDTCTL = KEYPAD_ROW_TICK;				// WDT as interval timer
+	IE1 |= WDTIE;
+} // end initKeypad()
+
+
+/* keypadGetEvent()
+ * 	Take the oldest event off the queue.
+ * @param: ev - filled in with the event
+ * @return: 1 if an event was taken, 0 if the queue is empty
+ */
+int keypadGetEvent(keyEvent *ev){
+	if(tail == head){
+		return 0;
+	}
+	*ev = queue[tail];
+	tail = (tail + 1) & (KEYPAD_QUEUE - 1);	// release the slot after the copy
+	return 1;
+} // end keypadGetEvent()
+
+
+/* keypadGetKey()
+ * 	Drain the queue up to the next key press.  For labs
+ * 	that only act on presses.
+ * @return: key index, KEY_NONE if no new press
+ */
+uint8_t keypadGetKey(){
+	keyEvent ev;
+	while(keypadGetEvent(&ev)){
+		if(ev.type == KEY_PRESSED){
+			return ev.key;
+		}
+	}
+	return KEY_NONE;
+} // end keypadGetKey()
+
+
+/* keypadPending()
+ * 	Call with interrupts off just before sleeping: a key
+ * 	queued after main's last read only wakes main if main is
+ * 	already asleep.
+ * @return: 1 if events are waiting in the queue
+ */
+uint8_t keypadPending(){
+	return tail != head;
+} // end keypadPending()
+
+
+/* keypadKeys()
+ * @return: debounced bitmap of every key down, bit n is key
+ * 		index n
+ */
+uint16_t keypadKeys(){
+	return keysDown;
+} // end keypadKeys()
+
+
+/* keypadDropped()
+ * @return: events lost to a full queue, saturates at 255
+ */
+uint8_t keypadDropped(){
+	return dropped;
+} // end keypadDropped()
+
+
+#ifdef KEYPAD_SELFTEST
+/* keypadSelfTest()
+ * 	Run the P2IN pattern of every single key, on every row,
+ * 	through colDecode[] and keymap[] and check each gives
+ * 	the value of the key the wiring says: P2IN 0x0D, 0x25,
+ * 	0x29, 0x2C for columns 0-3, key index (column << 2) |
+ * 	row.  The idle pattern must decode to no key.  Touches
+ * 	no hardware.
+ * @return: number of patterns that decoded wrong, 0 if all
+ * 		pass
+ */
+int keypadSelfTest(){
+	static const uint8_t colIn[4] = {0x0D, 0x25, 0x29, 0x2C};
+	uint16_t raw;
+	uint8_t c, r, n;
+	int fails = 0;
+
+	for(c = 0; c < 4; c++){
+		for(r = 0; r < 4; r++){
+			raw = colDecode[COL_INDEX(colIn[c])] << r;
+			for(n = 0; n < 16 && raw != (uint16_t)1 << n; n++);
+			if(n == 16 || keymap[n] != keymap[(c << 2) | r]){
+				fails++;
+			}
+		}
+	}
+	if(colDecode[COL_INDEX(KEYPAD_COLS)] != 0){
+		fails++;
+	}
+	return fails;
+} // end keypadSelfTest()
+#endif
+
+
+/* keypadClock()
+ * @return: deepest LPM the driver allows, for the scheduler.
+ * 		The WDT walks the rows even while parked.
+ */
+uint16_t keypadClock(){
+	return LPM3_bits;
+} // end keypadClock()
+
+
+// Column edge interrupt service routine
+#pragma vector=PORT2_VECTOR
+__interrupt void keypadEdge(void){
+	uint8_t h = head;
+
+	P2IE &=~ KEYPAD_COLS;					// the row scan makes its own edges
+	P2IFG &=~ KEYPAD_COLS;
+	scanning = 1;
+	keypadSample();							// first sample right away
+	if(head != h){
+		__bic_SR_register_on_exit(LPM4_bits);	// wake main
+	}
+} // end keypadEdge()
+
+
+// WDT interval interrupt service routine
+#pragma vector=WDT_VECTOR
+__interrupt void keypadTick(void){
+	uint8_t h = head;
+
+	keypadTicks++;
+	if(scanning){
+		keypadSample();
+		if(head != h){
+			__bic_SR_register_on_exit(LPM4_bits);	// wake main
+		}
+	}
+	else{
+		// walk the parked row.  A key already held on the
+		// new row raises the edge here.
+		parkedRow = (parkedRow + 1) & 0x03;
+		P1OUT = (P1OUT & ~KEYPAD_MUX) | muxRow[parkedRow];
+	}
+} // end keypadTick()
@@ -0,0 +1,110 @@
+/*************************************************************
+ * File:	keypad.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Shared 4x4 keypad driver.  Ports 1.3 and
+ * 	KEYPAD_MUX_HI strobe the deMUX input; ports 2.0, 2.2,
+ * 	2.3, 2.5 listen to the deMUX output.
+ *
+ * 	The deMUX can only pull one row low at a time, so while
+ * 	idle the row is parked and the WDT interval timer (ACLK
+ * 	from VLO) walks it across the four rows.  A key on the
+ * 	parked row pulls its column low and fires PORT2_VECTOR.
+ *
+ * 	The edge interrupt scans all four rows at once, reading
+ * 	every key down (n-key rollover), and a key that reads
+ * 	down is reported pressed from that interrupt, with no
+ * 	WDT tick to wait for.  From then on every WDT tick scans
+ * 	again and runs the debounce, which only holds off
+ * 	releases: a key must read up for KEYPAD_DEBOUNCE ticks
+ * 	in a row, ~16 ms by default, before it is reported
+ * 	released.
+ * 	State changes are pushed as timestamped events into a
+ * 	ring buffer that main drains with keypadGetEvent().
+ * 	Before sleeping main checks keypadPending() with
+ * 	interrupts off, so a key queued after its last read is
+ * 	not left waiting for some later wake.
+ * 	Once every key has been released the driver parks again.
+ * 	Everything runs from ACLK, so callers may sleep in LPM3
+ * 	between events.  keypadClock() says so to the scheduler,
+ * 	and defining KEYPAD_EVENT in keypad_config.h posts that
+ * 	scheduler event with every queued key event.
+ *
+ * 	Defining KEYPAD_SELFTEST in keypad_config.h builds
+ * 	keypadSelfTest(), which checks the column decode of all
+ * 	16 keys without touching the keypad.
+ *
+ * 	Each lab provides a keypad_config.h on its include path.
+ ************************************************************/
+
+#ifndef KEYPAD_H_
+#define KEYPAD_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include "keypad_config.h"
+
+// deMUX select lines on P1, overridable in keypad_config.h
+#ifndef KEYPAD_MUX_LO
+#define KEYPAD_MUX_LO	BIT3
+#endif
+#ifndef KEYPAD_MUX_HI
+#define KEYPAD_MUX_HI	BIT4
+#endif
+#define KEYPAD_MUX		(KEYPAD_MUX_LO + KEYPAD_MUX_HI)
+
+// Keymaps, selected with KEYPAD_KEYMAP in keypad_config.h
+#define KEYMAP_HEX		0		// key value 0x0-0xF, * = E, # = F
+#define KEYMAP_7SEG		1		// SAA1064 segment codes
+#define KEYMAP_ASCII	2		// ASCII, * = 0x00 (backspace)
+#ifndef KEYPAD_KEYMAP
+#define KEYPAD_KEYMAP	KEYMAP_HEX
+#endif
+
+// Timing in WDT ticks, overridable in keypad_config.h
+#ifndef KEYPAD_DEBOUNCE
+#define KEYPAD_DEBOUNCE	3		// samples a key must read up to release, max 8
+#endif
+#ifndef KEYPAD_HOLD
+#define KEYPAD_HOLD		60		// press to first KEY_HELD, ~320 ms
+#endif
+#ifndef KEYPAD_REPEAT
+#define KEYPAD_REPEAT	12		// KEY_HELD repeat while down, ~64 ms
+#endif
+
+#define KEYPAD_COLS		(BIT0 + BIT2 + BIT3 + BIT5)	// column inputs on P2
+#define KEYPAD_ROW_TICK	WDT_ADLY_1_9	// ACLK/64, ~5 ms per tick from VLO
+#define KEYPAD_SETTLE	10		// cycles for the columns to follow a row change
+#define KEYPAD_QUEUE	8		// event queue length, power of two
+#define KEY_NONE		0xFF
+
+// Event types
+#define KEY_PRESSED		0
+#define KEY_HELD		1
+#define KEY_RELEASED	2
+
+/* Keys are reported as an index: (column << 2) | row.
+ * keymap[key] gives the value of the key in the keymap
+ * this lab was built with.
+ */
+typedef struct {
+	uint8_t key;			// key index
+	uint8_t type;			// KEY_PRESSED, KEY_HELD or KEY_RELEASED
+	uint16_t time;			// WDT tick count when the event was raised
+} keyEvent;
+
+extern const uint8_t keymap[16];
+
+// Function prototypes
+void initKeypad();
+int keypadGetEvent(keyEvent *ev);
+uint8_t keypadGetKey();
+uint8_t keypadPending();
+uint16_t keypadKeys();
+uint8_t keypadDropped();
+uint16_t keypadClock();
+#ifdef KEYPAD_SELFTEST
+int keypadSelfTest();
+#endif
+
+#endif /* KEYPAD_H_ */
@@ -0,0 +1,216 @@
+/*************************************************************
+ * File:	lcd.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	NHD-C0216CZ 2x16 LCD driver.  See lcd.h.
+ ************************************************************/
+
+#include "lcd.h"
+
+#define RESET_DLY		SPI_NS_CYCLES(75000UL)	// slave start up after reset
+
+// Module variables
+static uint8_t fb[LCD_CELLS];				// what the LCD should show
+static uint8_t dirtyLo[LCD_ROWS];			// first dirty column of each row
+static uint8_t dirtyHi[LCD_ROWS];			// last dirty column, below dirtyLo if clean
+static const uint8_t lineAddr[LCD_ROWS] = {LCD_LINE1, LCD_LINE2};
+static const uint8_t *glyphs[LCD_GLYPHS];	// bitmap in each CGRAM slot, 0 if empty
+static uint8_t lru[LCD_GLYPHS];				// slots, most recently used first
+static uint8_t uploadBits;					// slots whose bitmap is still to be sent
+
+
+/* lcdCmd()
+ * 	Queue an instruction tagged with its execution time.
+ * 	Clear and return home (0x01-0x03) take 1.08 ms, and the
+ * 	wake up is given as long; every other instruction, and
+ * 	every data write, takes 26.3 us.
+ */
+static void lcdCmd(uint8_t cmd){
+	if(cmd <= 0x03 || cmd == LCD_WAKE_UP){
+		spiPut(cmd, SPI_CMD + SPI_LONG);
+	}
+	else{
+		spiPut(cmd, SPI_CMD);
+	}
+} // end lcdCmd()
+
+
+/* initLCD()
+ * 	Reset the LCD and send the startup sequence from the
+ * 	NHD-C0216CZ-NSW-BBW-3V3 datasheet, then blank the
+ * 	framebuffer.  initSPI() must have been called first.
+ * 	Returns once the sequence is queued; the SPI queue paces
+ * 	it from interrupts once the caller enables them.
+ */
+void initLCD(){
+	uint8_t i;
+
+	P1OUT &= ~LCD_RST;						// Now with SPI signals initialized,
+	P1OUT |= LCD_RST;						// reset slave
+	__delay_cycles(RESET_DLY);				// Wait for slave to initialize
+
+	lcdCmd(LCD_WAKE_UP);					// Time to wake up LCD
+	lcdCmd(LCD_WAKE_UP);
+	lcdCmd(LCD_WAKE_UP);
+	lcdCmd(LCD_FUNC_SET);					// Start predefined initialization sequence
+	lcdCmd(LCD_OSC_FREQ);
+	lcdCmd(LCD_PWR_CNTR);
+	lcdCmd(LCD_FOL_CNTR);
+	lcdCmd(LCD_CONTRAST);
+	lcdCmd(LCD_FUNC_NORM);					// table 0, for CGRAM access
+	lcdCmd(LCD_DISP_ON);
+	lcdCmd(LCD_CLEAR);						// the queue holds off for it
+
+	for(i = 0; i < LCD_CELLS; i++){
+		fb[i] = ' ';						// what clear leaves behind
+	}
+	for(i = 0; i < LCD_ROWS; i++){
+		dirtyLo[i] = LCD_COLS;
+		dirtyHi[i] = 0;
+	}
+	for(i = 0; i < LCD_GLYPHS; i++){
+		glyphs[i] = 0;
+		lru[i] = i;
+	}
+	uploadBits = 0;
+} // end initLCD()
+
+
+/* lcdSetChar()
+ * 	Put a character in the framebuffer.
+ * @param: pos - cell, 0-31
+ * @param: c - character code
+ */
+void lcdSetChar(uint8_t pos, uint8_t c){
+	uint8_t row, col;
+
+	if(pos >= LCD_CELLS || fb[pos] == c){
+		return;
+	}
+	fb[pos] = c;
+	row = pos / LCD_COLS;
+	col = pos % LCD_COLS;
+	if(dirtyHi[row] < dirtyLo[row]){
+		dirtyLo[row] = col;					// row was clean
+		dirtyHi[row] = col;
+	}
+	else if(col < dirtyLo[row]){
+		dirtyLo[row] = col;
+	}
+	else if(col > dirtyHi[row]){
+		dirtyHi[row] = col;
+	}
+} // end lcdSetChar()
+
+
+/* lcdGetChar()
+ * @param: pos - cell, 0-31
+ * @return: character in the framebuffer
+ */
+uint8_t lcdGetChar(uint8_t pos){
+	return pos < LCD_CELLS ? fb[pos] : ' ';
+} // end lcdGetChar()
+
+
+/* lcdShowing()
+ * @param: slot - CGRAM slot
+ * @param: skip - cell to leave out
+ * @return: 1 if any other cell of the framebuffer shows slot
+ */
+static uint8_t lcdShowing(uint8_t slot, uint8_t skip){
+	uint8_t i;
+
+	for(i = 0; i < LCD_CELLS; i++){
+		if(fb[i] == slot && i != skip){
+			return 1;
+		}
+	}
+	return 0;
+} // end lcdShowing()
+
+
+/* lcdSetGlyph()
+ * 	Put a custom glyph in the framebuffer.  A resident glyph
+ * 	is only marked used.  Otherwise it takes the least
+ * 	recently used slot that no other cell shows, and the
+ * 	next lcdFlush() uploads it.
+ * @param: pos - cell, 0-31
+ * @param: glyph - 8 row bitmap, see lcd.h
+ * @return: 1 if placed, 0 if all eight slots are on screen
+ */
+int lcdSetGlyph(uint8_t pos, const uint8_t *glyph){
+	uint8_t i, slot;
+
+	for(i = 0; i < LCD_GLYPHS; i++){
+		if(glyphs[lru[i]] == glyph){
+			break;
+		}
+	}
+	if(i == LCD_GLYPHS){
+		// evict from the cold end, but never a glyph on screen
+		do{
+			if(i == 0){
+				return 0;
+			}
+			i--;
+		} while(glyphs[lru[i]] && lcdShowing(lru[i], pos));
+		glyphs[lru[i]] = glyph;
+		uploadBits |= 1 << lru[i];
+	}
+	slot = lru[i];
+	for(; i > 0; i--){
+		lru[i] = lru[i - 1];				// move to the hot end
+	}
+	lru[0] = slot;
+	lcdSetChar(pos, slot);
+	return 1;
+} // end lcdSetGlyph()
+
+
+/* lcdFlush()
+ * 	Queue the CGRAM upload of each new glyph: one set CGRAM
+ * 	address command, then its 8 rows.  Then queue the dirty
+ * 	span of each row: one set DDRAM address command, then
+ * 	the data bytes.  A span that does not fit in the SPI
+ * 	queue goes out in part; the rest stays dirty for the
+ * 	next call.  Spans wait until every upload is queued.
+ */
+void lcdFlush(){
+	uint8_t row, col, len, room, slot;
+
+	for(slot = 0; uploadBits; slot++){
+		if(!(uploadBits & (1 << slot))){
+			continue;
+		}
+		if(spiFree() < 9){
+			return;
+		}
+		spiPut(LCD_CGRAM | (slot << 3), SPI_CMD);
+		spiWrite(glyphs[slot], 8, SPI_DATA);
+		uploadBits &=~ (1 << slot);
+	}
+	for(row = 0; row < LCD_ROWS; row++){
+		if(dirtyHi[row] < dirtyLo[row]){
+			continue;
+		}
+		room = spiFree();
+		if(room < 2){
+			return;
+		}
+		col = dirtyLo[row];
+		len = dirtyHi[row] - col + 1;
+		if(len > room - 1){
+			len = room - 1;
+		}
+		spiPut(LCD_DDRAM | (lineAddr[row] + col), SPI_CMD);
+		spiWrite(&fb[row * LCD_COLS + col], len, SPI_DATA);
+		col += len;
+		if(col > dirtyHi[row]){
+			dirtyLo[row] = LCD_COLS;		// clean
+			dirtyHi[row] = 0;
+		}
+		else{
+			dirtyLo[row] = col;
+		}
+	}
+} // end lcdFlush()
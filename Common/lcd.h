@@ -0,0 +1,94 @@
+/*************************************************************
+ * File:	lcd.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Newhaven NHD-C0216CZ 2x16 character LCD
+ * 	(ST7032 controller) on the SPI output queue.
+ *
+ * 	The driver keeps a framebuffer of both rows.  Writers
+ * 	only change the framebuffer, which marks the changed
+ * 	range of each row dirty.  lcdFlush() queues one set DDRAM
+ * 	address command per dirty span followed by its data
+ * 	bytes as one burst under a single CS; the LCD's address
+ * 	auto-increment places them.
+ *
+ * 	Instructions are tagged with their execution time, and
+ * 	the SPI queue holds each byte off until the controller
+ * 	is ready for it.  spi_config.h gives the times: 26.3 us
+ * 	for data and most instructions, 1.08 ms for clear and
+ * 	return home, both at the slowest oscillator.
+ *
+ * 	The eight CGRAM characters are a glyph cache.
+ * 	lcdSetGlyph() puts a 5x8 bitmap in a cell: a glyph
+ * 	already resident costs one data byte like any other
+ * 	character, and a new one takes the least recently used
+ * 	slot that is not on screen.  lcdFlush() uploads new
+ * 	slots before it sends any dirty spans.
+ *
+ * 	lcd_print.c formats strings and numbers straight into
+ * 	the framebuffer.  Every print takes a starting cell and
+ * 	returns the cell after what it wrote, so fields can be
+ * 	chained.
+ *
+ * 	Each lab provides an lcd_config.h on its include path.
+ ************************************************************/
+
+#ifndef LCD_H_
+#define LCD_H_
+
+#include <stdint.h>
+#include "spi.h"
+#include "lcd_config.h"
+
+// Wiring and DDRAM layout, overridable in lcd_config.h
+#ifndef LCD_RST
+#define LCD_RST			BIT5	// slave reset on P1
+#endif
+#ifndef LCD_LINE1
+#define LCD_LINE1		0x00	// DDRAM address of the first cell of row 0
+#endif
+#ifndef LCD_LINE2
+#define LCD_LINE2		0x40	// DDRAM address of the first cell of row 1
+#endif
+
+#define LCD_ROWS		2
+#define LCD_COLS		16
+#define LCD_CELLS		(LCD_ROWS * LCD_COLS)
+
+// Instructions
+#define LCD_CLEAR		0x01
+#define LCD_DISP_ON		0x0C
+#define LCD_WAKE_UP		0x30
+#define LCD_FUNC_SET	0x39	// 8 bit, 2 lines, instruction table 1
+#define LCD_FUNC_NORM	0x38	// 8 bit, 2 lines, instruction table 0
+#define LCD_OSC_FREQ	0x14
+#define LCD_CONTRAST	0x70
+#define LCD_PWR_CNTR	0x56
+#define LCD_FOL_CNTR	0x6D
+#define LCD_DDRAM		0x80	// set DDRAM address, OR in the address
+#define LCD_CGRAM		0x40	// set CGRAM address, OR in slot << 3 (table 0)
+
+#define LCD_GLYPHS		8		// CGRAM slots, character codes 0-7
+
+/* Cells are addressed by position: row * LCD_COLS + column,
+ * 0-15 on the top row and 16-31 on the bottom row.
+ *
+ * A glyph is 8 rows of 5 bits, top row first, bit 4 on the
+ * left.  The cache knows a glyph by its address, so it must
+ * be const and stay put.
+ */
+
+// Function prototypes
+void initLCD();
+void lcdSetChar(uint8_t pos, uint8_t c);
+uint8_t lcdGetChar(uint8_t pos);
+void lcdFlush();
+int lcdSetGlyph(uint8_t pos, const uint8_t *glyph);
+uint8_t lcdPrint(uint8_t pos, const char *s);
+uint8_t lcdPrintUint(uint8_t pos, uint16_t v, uint8_t width);
+uint8_t lcdPrintInt(uint8_t pos, int16_t v, uint8_t width);
+uint8_t lcdPrintHex(uint8_t pos, uint16_t v, uint8_t digits);
+uint8_t lcdPrintFixed(uint8_t pos, int16_t v, uint8_t frac, uint8_t width);
+uint8_t lcdPrintBar(uint8_t pos, uint8_t v, uint8_t width);
+
+#endif /* LCD_H_ */
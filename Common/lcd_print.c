@@ -0,0 +1,208 @@
+/*************************************************************
+ * File:	lcd_print.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Text and number formatting into the LCD
+ * 	framebuffer.  See lcd.h.
+ *
+ * 	No printf and no heap: every field is built in a small
+ * 	buffer on the stack.  The G2553 has no hardware divider,
+ * 	so digits come from subtracting powers of ten, at most
+ * 	nine subtractions a digit, instead of / and %.
+ ************************************************************/
+
+#include "lcd.h"
+
+#define FIELD_MAX		8		// "-3276.8" plus room for the point
+
+// Module variables
+static const uint16_t pow10[5] = {10000, 1000, 100, 10, 1};
+static const char hexDigit[16] = "0123456789ABCDEF";
+
+// Bar graph glyphs, 1 to 5 columns lit from the left
+static const uint8_t bar[5][8] = {
+	{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10},
+	{0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18},
+	{0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C},
+	{0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E},
+	{0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F}
+};
+
+
+/* lcdDigits()
+ * 	Convert to decimal without dividing.
+ * @param: buf - filled in with the digits, most significant
+ * 		first, at least 5 long
+ * @param: v - value
+ * @param: minDigits - zero pad to this many digits, 1-5
+ * @return: number of digits written
+ */
+static uint8_t lcdDigits(char *buf, uint16_t v, uint8_t minDigits){
+	uint8_t i, n = 0;
+	char d;
+
+	for(i = 0; i < 5; i++){
+		d = '0';
+		while(v >= pow10[i]){
+			v -= pow10[i];
+			d++;
+		}
+		if(n || d != '0' || i >= 5 - minDigits){
+			buf[n++] = d;
+		}
+	}
+	return n;
+} // end lcdDigits()
+
+
+/* lcdField()
+ * 	Write a field right aligned in width cells, space
+ * 	padded.  A field too long for its width is shown as
+ * 	width '*'s rather than cut.
+ * @param: width - cells, 0 to fit the field exactly
+ * @return: cell after the field
+ */
+static uint8_t lcdField(uint8_t pos, const char *buf, uint8_t n, uint8_t width){
+	uint8_t i;
+
+	if(width == 0){
+		width = n;
+	}
+	if(n > width){
+		for(i = 0; i < width; i++){
+			lcdSetChar(pos++, '*');
+		}
+		return pos;
+	}
+	for(i = n; i < width; i++){
+		lcdSetChar(pos++, ' ');
+	}
+	for(i = 0; i < n; i++){
+		lcdSetChar(pos++, buf[i]);
+	}
+	return pos;
+} // end lcdField()
+
+
+/* lcdPrint()
+ * 	Write a string.
+ * @param: pos - first cell, 0-31
+ * @param: s - NUL terminated string
+ * @return: cell after the string
+ */
+uint8_t lcdPrint(uint8_t pos, const char *s){
+	while(*s){
+		lcdSetChar(pos++, *s++);
+	}
+	return pos;
+} // end lcdPrint()
+
+
+/* lcdPrintUint()
+ * 	Write an unsigned decimal.
+ * @param: pos - first cell, 0-31
+ * @param: v - value
+ * @param: width - field width, right aligned; 0 to fit
+ * @return: cell after the field
+ */
+uint8_t lcdPrintUint(uint8_t pos, uint16_t v, uint8_t width){
+	char buf[FIELD_MAX];
+	uint8_t n = lcdDigits(buf, v, 1);
+	return lcdField(pos, buf, n, width);
+} // end lcdPrintUint()
+
+
+/* lcdPrintInt()
+ * 	Write a signed decimal.
+ * @param: pos - first cell, 0-31
+ * @param: v - value
+ * @param: width - field width, right aligned; 0 to fit
+ * @return: cell after the field
+ */
+uint8_t lcdPrintInt(uint8_t pos, int16_t v, uint8_t width){
+	char buf[FIELD_MAX];
+	uint8_t n = 0;
+
+	if(v < 0){
+		buf[n++] = '-';
+	}
+	n += lcdDigits(&buf[n], v < 0 ? -(uint16_t)v : (uint16_t)v, 1);
+	return lcdField(pos, buf, n, width);
+} // end lcdPrintInt()
+
+
+/* lcdPrintHex()
+ * 	Write an unsigned hex number, zero padded.
+ * @param: pos - first cell, 0-31
+ * @param: v - value
+ * @param: digits - digits to show, 1-4
+ * @return: cell after the field
+ */
+uint8_t lcdPrintHex(uint8_t pos, uint16_t v, uint8_t digits){
+	if(digits > 4){
+		digits = 4;
+	}
+	while(digits--){
+		lcdSetChar(pos++, hexDigit[(v >> (digits << 2)) & 0x0F]);
+	}
+	return pos;
+} // end lcdPrintHex()
+
+
+/* lcdPrintFixed()
+ * 	Write a fixed point decimal: v / 10^frac, e.g. v = 1500,
+ * 	frac = 3 shows "1.500".
+ * @param: pos - first cell, 0-31
+ * @param: v - value scaled by 10^frac
+ * @param: frac - digits after the point, 0-4
+ * @param: width - field width, right aligned; 0 to fit
+ * @return: cell after the field
+ */
+uint8_t lcdPrintFixed(uint8_t pos, int16_t v, uint8_t frac, uint8_t width){
+	char buf[FIELD_MAX];
+	uint8_t n = 0, d, i;
+
+	if(frac > 4){
+		frac = 4;
+	}
+	if(v < 0){
+		buf[n++] = '-';
+	}
+	d = lcdDigits(&buf[n], v < 0 ? -(uint16_t)v : (uint16_t)v, frac + 1);
+	n += d;
+	if(frac){
+		// open a gap for the point
+		for(i = n; i > n - frac; i--){
+			buf[i] = buf[i - 1];
+		}
+		buf[n - frac] = '.';
+		n++;
+	}
+	return lcdField(pos, buf, n, width);
+} // end lcdPrintFixed()
+
+
+/* lcdPrintBar()
+ * 	Write a horizontal bar graph, 5 pixel columns per cell,
+ * 	from the bar glyphs in the CGRAM cache.  A cell whose
+ * 	glyph finds no free slot shows '#' instead.
+ * @param: pos - first cell, 0-31
+ * @param: v - lit columns, 0 to 5 * width
+ * @param: width - cells
+ * @return: cell after the bar
+ */
+uint8_t lcdPrintBar(uint8_t pos, uint8_t v, uint8_t width){
+	while(width--){
+		if(v == 0){
+			lcdSetChar(pos, ' ');
+		}
+		else{
+			if(!lcdSetGlyph(pos, bar[(v > 5 ? 5 : v) - 1])){
+				lcdSetChar(pos, '#');
+			}
+			v = v > 5 ? v - 5 : 0;
+		}
+		pos++;
+	}
+	return pos;
+} // end lcdPrintBar()
@@ -0,0 +1,174 @@
+/*************************************************************
+ * File:	motion.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Acceleration limited motion profiles.  See
+ * 	motion.h.
+ ************************************************************/
+
+#include "motion.h"
+
+// Channel configuration
+static volatile unsigned int * const ccr[MOTION_CHANNELS] = MOTION_CCR;
+static const int16_t vmax[MOTION_CHANNELS] = MOTION_VMAX;
+static const int16_t amax[MOTION_CHANNELS] = MOTION_AMAX;
+
+// Module variables
+static volatile int16_t target[MOTION_CHANNELS];
+static volatile int16_t pos[MOTION_CHANNELS];	// pulse width going out
+static int16_t vel[MOTION_CHANNELS];			// counts per period, signed
+
+
+/* brake()
+ * 	Distance covered while braking to a stop, one
+ * 	acceleration step per period.  No division, the G2553
+ * 	has no divider.
+ * @param: sp - speed now
+ * @param: a - acceleration
+ * @return: counts travelled after this period
+ */
+static int16_t brake(int16_t sp, int16_t a){
+	int16_t d = 0;
+
+	while(sp > a){
+		sp -= a;
+		d += sp;
+	}
+	return d;
+} // end brake()
+
+
+/* initMotion()
+ * 	Start every channel at rest where its compare register
+ * 	already is.  The PWM timers must already be running.
+ */
+void initMotion(){
+	uint8_t ch;
+
+	TA1CCTL0 = 0;
+	for(ch = 0; ch < MOTION_CHANNELS; ch++){
+		pos[ch] = *ccr[ch];
+		target[ch] = pos[ch];
+		vel[ch] = 0;
+	}
+} // end initMotion()
+
+
+/* motionSetTarget()
+ * 	Move a channel to a new pulse width.  Returns at once.
+ * @param: ch - channel
+ * @param: t - target pulse width, timer counts
+ */
+void motionSetTarget(uint8_t ch, int16_t t){
+	target[ch] = t;
+	TA1CCTL0 = CCIE;						// step from the next period
+} // end motionSetTarget()
+
+
+/* motionStop()
+ * 	Bring a channel to rest as soon as its acceleration
+ * 	allows: the target becomes wherever braking from the
+ * 	current speed ends.
+ * @param: ch - channel
+ */
+void motionStop(uint8_t ch){
+	unsigned short state;
+	int16_t v;
+
+	state = __get_interrupt_state();
+	__disable_interrupt();
+	v = vel[ch];
+	if(v >= 0){
+		target[ch] = pos[ch] + brake(v, amax[ch]);
+	}
+	else{
+		target[ch] = pos[ch] - brake(-v, amax[ch]);
+	}
+	__set_interrupt_state(state);
+} // end motionStop()
+
+
+/* motionTarget()
+ * @param: ch - channel
+ * @return: pulse width the channel is heading to
+ */
+int16_t motionTarget(uint8_t ch){
+	return target[ch];
+} // end motionTarget()
+
+
+/* motionPosition()
+ * @param: ch - channel
+ * @return: pulse width going out this period
+ */
+int16_t motionPosition(uint8_t ch){
+	return pos[ch];
+} // end motionPosition()
+
+
+/* motionIdle()
+ * @return: 1 once every channel is at rest on its target
+ */
+uint8_t motionIdle(){
+	return !(TA1CCTL0 & CCIE);
+} // end motionIdle()
+
+
+/* motionStep()
+ * 	Advance one channel by one period.
+ * @return: 1 if the channel is still moving
+ */
+static uint8_t motionStep(uint8_t ch){
+	int16_t err = target[ch] - pos[ch];
+	int16_t v = vel[ch];
+	int16_t a = amax[ch];
+	int16_t dist, sp;
+
+	if(err == 0 && v == 0){
+		return 0;
+	}
+	dist = err < 0 ? -err : err;
+	sp = v < 0 ? -v : v;
+	if(dist <= a && sp <= a){
+		// close and slow enough to land this period
+		pos[ch] = target[ch];
+		vel[ch] = 0;
+	}
+	else if((v > 0 && err <= 0) || (v < 0 && err >= 0)){
+		// moving away from the target, brake first
+		v = sp > a ? (v > 0 ? v - a : v + a) : 0;
+		pos[ch] += v;
+		vel[ch] = v;
+	}
+	else{
+		// speed up, hold or slow down, whichever still stops in time
+		v = sp + a < vmax[ch] ? sp + a : vmax[ch];
+		if(v + brake(v, a) > dist){
+			v = sp < vmax[ch] ? sp : vmax[ch];
+			if(v + brake(v, a) > dist){
+				v = sp > a ? sp - a : 0;
+			}
+		}
+		if(err < 0){
+			v = -v;
+		}
+		pos[ch] += v;
+		vel[ch] = v;
+	}
+	*ccr[ch] = pos[ch];
+	return 1;
+} // end motionStep()
+
+
+// Timer1_A CCR0 interrupt service routine, once per PWM period
+#pragma vector=TIMER1_A0_VECTOR
+__interrupt void motionTick(void){
+	uint8_t ch, moving = 0;
+
+	for(ch = 0; ch < MOTION_CHANNELS; ch++){
+		moving |= motionStep(ch);
+	}
+	if(!moving){
+		TA1CCTL0 = 0;						// all at rest, stop ticking
+	}
+} // end motionTick()
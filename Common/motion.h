@@ -0,0 +1,59 @@
+/*************************************************************
+ * File:	motion.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Acceleration limited motion profiles for PWM
+ * 	servo channels.
+ *
+ * 	Each channel drives one compare register.  The caller
+ * 	sets a target pulse width; once per PWM period the
+ * 	Timer_A1 CCR0 interrupt moves every channel one step
+ * 	toward its target.  Speed changes by at most the
+ * 	channel's acceleration per period and never exceeds its
+ * 	velocity, and the channel brakes in time to land on the
+ * 	target.  A new target in the other direction brakes to a
+ * 	stop first, so a hard reversal becomes a ramp through
+ * 	STOP.  Motion depends only on the PWM period, not on how
+ * 	often main runs.
+ *
+ * 	Compare registers are only written from the period
+ * 	interrupt, while every output is in its high phase, so
+ * 	no pulse is cut short or doubled.  Channels on Timer0_A
+ * 	need it running the same period, started together with
+ * 	Timer1_A.
+ *
+ * 	The interrupt stops itself once every channel is at
+ * 	rest.  The driver owns TIMER1_A0_VECTOR.
+ *
+ * 	Each lab provides a motion_config.h on its include path.
+ ************************************************************/
+
+#ifndef MOTION_H_
+#define MOTION_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include "motion_config.h"
+
+/* motion_config.h declares MOTION_CHANNELS and, with one
+ * entry per channel:
+ * 	MOTION_CCR	 - compare register address
+ * 	MOTION_VMAX	 - top speed, counts per period
+ * 	MOTION_AMAX	 - acceleration, counts per period per period
+ */
+#if !defined(MOTION_CHANNELS) || !defined(MOTION_CCR)
+#error "motion_config.h must declare MOTION_CHANNELS and MOTION_CCR"
+#endif
+#if !defined(MOTION_VMAX) || !defined(MOTION_AMAX)
+#error "motion_config.h must declare MOTION_VMAX and MOTION_AMAX"
+#endif
+
+// Function prototypes
+void initMotion();
+void motionSetTarget(uint8_t ch, int16_t target);
+void motionStop(uint8_t ch);
+int16_t motionTarget(uint8_t ch);
+int16_t motionPosition(uint8_t ch);
+uint8_t motionIdle();
+
+#endif /* MOTION_H_ */
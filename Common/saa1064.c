@@ -0,0 +1,200 @@
+/*************************************************************
+ * File:	saa1064.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	SAA1064 4 digit LED driver.  See saa1064.h.
+ ************************************************************/
+
+#include "saa1064.h"
+
+#if SAA1064_CHECK < 1 || SAA1064_CHECK > 255
+#error "SAA1064_CHECK must be 1-255 frames"
+#endif
+
+#define REG_COUNT		(1 + SAA1064_DIGITS)	// subaddress 0 is control, 1-4 the digits
+#define REG_ALL			((1 << REG_COUNT) - 1)
+
+// Module variables
+static uint8_t shadow[REG_COUNT];			// what the chip should hold
+static uint8_t frame[REG_COUNT + 1];		// subaddress + span, owned by the queue while busy
+static uint8_t ledStatus;					// status byte, owned by the queue while busy
+static volatile uint8_t dirty = 0;			// bit n - shadow[n] is not on the chip yet
+static volatile uint8_t inFlight = 0;		// registers the frame in flight carries
+static volatile uint8_t busy = 0;			// 1 - a transfer of ours is queued or on the bus
+static volatile uint8_t checkStatus = 0;	// 1 - status read due
+static uint8_t framesLeft = SAA1064_CHECK;	// good frames until the next status read
+static volatile uint8_t stalled = 0;		// 1 - last frame failed, wait for a change
+static volatile uint8_t errors = 0;
+
+
+static void frameDone(uint8_t result);
+static void statusDone(uint8_t result);
+static i2cTxn frameTxn = {SAA1064_ADDR, frame, 0, 0, 0, frameDone, I2C_IDLE, 0};
+static i2cTxn statusTxn = {SAA1064_ADDR, 0, 0, &ledStatus, 1, statusDone, I2C_IDLE, 0};
+
+
+/* displayError()
+ * 	Count a failed transfer.  Interrupt context.
+ */
+static void displayError(){
+	if(errors < 0xFF){
+		errors++;
+	}
+} // end displayError()
+
+
+/* frameDone()
+ * 	I2C completion callback for a register frame.
+ * @param: result - final I2C status
+ */
+static void frameDone(uint8_t result){
+	if(result == I2C_DONE){
+		if(--framesLeft == 0){
+			checkStatus = 1;
+		}
+	}
+	else{
+		// the chip may hold any of the span now, send it again
+		// with the next change rather than hammer a dead bus.
+		// It may also have reset, so ask once.
+		dirty |= inFlight;
+		stalled = 1;
+		checkStatus = 1;
+		displayError();
+	}
+	inFlight = 0;
+	busy = 0;
+} // end frameDone()
+
+
+/* statusDone()
+ * 	I2C completion callback for the status read.  Reading the
+ * 	status clears its POR flag, so a set flag means the chip
+ * 	reset since the last read.  A chip that answers also ends
+ * 	a stall, so a failed span goes out again.
+ * @param: result - final I2C status
+ */
+static void statusDone(uint8_t result){
+	if(result != I2C_DONE){
+		displayError();
+	}
+	else{
+		if(ledStatus & SAA1064_POR){
+			dirty = REG_ALL;
+		}
+		stalled = 0;
+		framesLeft = SAA1064_CHECK;
+	}
+	busy = 0;
+} // end statusDone()
+
+
+/* initDisplay()
+ * 	Blank the shadow and mark every register dirty so the
+ * 	first flush programs the chip.  initI2C() must have been
+ * 	called first.
+ */
+void initDisplay(){
+	uint8_t i;
+
+	shadow[0] = SAA1064_CTRL;
+	for(i = 1; i < REG_COUNT; i++){
+		shadow[i] = 0x00;
+	}
+	dirty = REG_ALL;
+	stalled = 0;
+	checkStatus = 0;
+	framesLeft = SAA1064_CHECK;
+} // end initDisplay()
+
+
+/* displaySetDigit()
+ * 	Set one digit in the shadow.
+ * @param: digit - 0-3, 0 is leftmost
+ * @param: seg - segment code
+ */
+void displaySetDigit(uint8_t digit, uint8_t seg){
+	if(digit >= SAA1064_DIGITS){
+		return;
+	}
+	digit++;								// skip the control register
+	if(shadow[digit] != seg){
+		shadow[digit] = seg;
+		dirty |= 1 << digit;
+		stalled = 0;
+	}
+} // end displaySetDigit()
+
+
+/* displaySetControl()
+ * 	Set the control register in the shadow.
+ * @param: ctrl - SAA1064 control byte
+ */
+void displaySetControl(uint8_t ctrl){
+	if(shadow[0] != ctrl){
+		shadow[0] = ctrl;
+		dirty |= 1;
+		stalled = 0;
+	}
+} // end displaySetControl()
+
+
+/* displayFlush()
+ * 	Queue the next transfer the display needs, unless one is
+ * 	already queued: the dirty span first, then a status read
+ * 	if one is due.  Changes made while a frame waits for the
+ * 	bus pile up in the shadow and go out together in the
+ * 	next frame.
+ */
+void displayFlush(){
+	uint8_t lo, hi, i, mask;
+
+	if(busy){
+		return;
+	}
+	if(dirty && !stalled){
+		for(lo = 0; !(dirty & (1 << lo)); lo++);
+		for(hi = REG_COUNT - 1; !(dirty & (1 << hi)); hi--);
+		mask = ((2 << hi) - 1) & ~((1 << lo) - 1);
+
+		frame[0] = lo;						// subaddress, auto-increments
+		for(i = lo; i <= hi; i++){
+			frame[i - lo + 1] = shadow[i];
+		}
+		// claim the span before the transfer can finish
+		inFlight = mask;
+		dirty &=~ mask;
+		busy = 1;
+		frameTxn.txLen = hi - lo + 2;
+		if(!i2cSubmit(&frameTxn)){
+			dirty |= mask;
+			inFlight = 0;
+			busy = 0;
+		}
+	}
+	else if(checkStatus){
+		busy = 1;
+		if(i2cSubmit(&statusTxn)){
+			checkStatus = 0;
+		}
+		else{
+			busy = 0;
+		}
+	}
+} // end displayFlush()
+
+
+/* displayIdle()
+ * @return: 1 if nothing is left for displayFlush() to send
+ */
+uint8_t displayIdle(){
+	return !busy && !checkStatus && (!dirty || stalled);
+} // end displayIdle()
+
+
+/* displayErrors()
+ * @return: failed transfers, saturates at 255
+ */
+uint8_t displayErrors(){
+	return errors;
+} // end displayErrors()
@@ -0,0 +1,56 @@
+/*************************************************************
+ * File:	saa1064.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	SAA1064 4 digit LED driver on the shared I2C
+ * 	bus.  The driver keeps a shadow copy of the control
+ * 	register and the four digit registers.  Setters only
+ * 	touch the shadow and mark what changed; displayFlush()
+ * 	sends the smallest span that covers every dirty register,
+ * 	using the chip's subaddress auto-increment.
+ *
+ * 	Every SAA1064_CHECK good frames, and once after a frame
+ * 	fails, the status byte is read back.  If the chip has
+ * 	been through a power-on reset since the last read it has
+ * 	lost its registers, so the whole shadow is marked dirty
+ * 	and goes out again on the next flush.  In between, a
+ * 	one digit change is a single write on the bus.
+ *
+ * 	Transfers go through the I2C queue, so the display can
+ * 	share the bus with other devices.  displayFlush() never
+ * 	waits on the bus.  Call it again whenever the CPU wakes
+ * 	until displayIdle() returns 1.
+ *
+ * 	Each lab provides a saa1064_config.h on its include path.
+ ************************************************************/
+
+#ifndef SAA1064_H_
+#define SAA1064_H_
+
+#include <stdint.h>
+#include "i2c_queue.h"
+#include "saa1064_config.h"
+
+// Bus address, overridable in saa1064_config.h
+#ifndef SAA1064_ADDR
+#define SAA1064_ADDR	0x38	// 7 bit, ADR pin to VEE
+#endif
+#ifndef SAA1064_CTRL
+#define SAA1064_CTRL	0x37	// dynamic mode, all digits on, 12 mA
+#endif
+#ifndef SAA1064_CHECK
+#define SAA1064_CHECK	16		// good frames between status reads, 1-255
+#endif
+
+#define SAA1064_DIGITS	4
+#define SAA1064_POR		0x80	// status: power-on reset since the last read
+
+// Function prototypes
+void initDisplay();
+void displaySetDigit(uint8_t digit, uint8_t seg);
+void displaySetControl(uint8_t ctrl);
+void displayFlush();
+uint8_t displayIdle();
+uint8_t displayErrors();
+
+#endif /* SAA1064_H_ */
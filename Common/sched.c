@@ -0,0 +1,102 @@
+/*************************************************************
+ * File:	sched.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Run to completion event scheduler.  See
+ * 	sched.h.
+ ************************************************************/
+
+#include "sched.h"
+
+// Module variables
+static schedHandler handlers[SCHED_EVENTS];
+static volatile uint16_t pending = 0;		// bit n set while event n waits
+static schedClockFn clocks[SCHED_CLOCKS];
+static uint8_t clockCount = 0;
+
+
+/* initSched()
+ * 	Forget every handler, clock function and pending event.
+ */
+void initSched(){
+	uint8_t i;
+
+	for(i = 0; i < SCHED_EVENTS; i++){
+		handlers[i] = 0;
+	}
+	clockCount = 0;
+	pending = 0;
+} // end initSched()
+
+
+/* schedOn()
+ * 	Set the handler of an event.
+ * @param: ev - event, 0-15
+ * @param: fn - handler, 0 to drop the event
+ */
+void schedOn(uint8_t ev, schedHandler fn){
+	handlers[ev] = fn;
+} // end schedOn()
+
+
+/* schedPost()
+ * 	Mark an event pending.  Safe from interrupt context.
+ * @param: ev - event, 0-15
+ */
+void schedPost(uint8_t ev){
+	unsigned short state;
+
+	state = __get_interrupt_state();
+	__disable_interrupt();
+	pending |= 1 << ev;
+	__set_interrupt_state(state);
+} // end schedPost()
+
+
+/* schedClock()
+ * 	Add a driver's clock function.
+ * @param: fn - returns the deepest LPM bits the driver
+ * 		allows right now
+ * @return: 1 if added, 0 if SCHED_CLOCKS are already held
+ */
+int schedClock(schedClockFn fn){
+	if(clockCount >= SCHED_CLOCKS){
+		return 0;
+	}
+	clocks[clockCount++] = fn;
+	return 1;
+} // end schedClock()
+
+
+/* schedRun()
+ * 	Run handlers as their events come in, and sleep in
+ * 	between.  Enables interrupts.  Never returns.
+ */
+void schedRun(){
+	uint16_t lpm, need;
+	uint8_t ev, i;
+
+	while(1){
+		__disable_interrupt();
+		if(pending){
+			for(ev = 0; !(pending & (1 << ev)); ev++);
+			pending &=~ (1 << ev);
+			__enable_interrupt();
+			if(handlers[ev]){
+				handlers[ev]();
+			}
+			continue;
+		}
+		// nothing to do: the shallowest mode any driver needs.
+		// Interrupts stay off until the sleep itself enables
+		// them, so no event is missed in between.
+		lpm = LPM4_bits;
+		for(i = 0; i < clockCount; i++){
+			need = clocks[i]();
+			if(need < lpm){
+				lpm = need;
+			}
+		}
+		__bis_SR_register(lpm + GIE);
+	}
+} // end schedRun()
@@ -0,0 +1,58 @@
+/*************************************************************
+ * File:	sched.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Run to completion event scheduler with low
+ * 	power idle.
+ *
+ * 	An event is a number 0-15 with one handler.  ISRs and
+ * 	handlers call schedPost() to mark an event pending;
+ * 	schedRun() is main's loop and calls the handler of each
+ * 	pending event from main, lowest number first, one at a
+ * 	time and to completion.  Posting an event already
+ * 	pending does nothing, so a burst of interrupts costs one
+ * 	handler call.
+ *
+ * 	With nothing pending the scheduler sleeps as deep as
+ * 	every driver allows.  Each driver with a clock to keep
+ * 	running gives a clock function returning the deepest LPM
+ * 	it can stand right now: LPM0_bits while it needs SMCLK,
+ * 	LPM3_bits while it needs ACLK, LPM4_bits when it needs
+ * 	none.  The lab registers one with schedClock() for each
+ * 	driver it uses.  A driver whose ISRs start SMCLK work on
+ * 	their own must ask for LPM0 until it is idle.
+ *
+ * 	The ISR that posts must still wake main with
+ * 	__bic_SR_register_on_exit(); every driver here already
+ * 	does when it has news for main.
+ *
+ * 	Each lab provides a sched_config.h on its include path
+ * 	naming its events.
+ ************************************************************/
+
+#ifndef SCHED_H_
+#define SCHED_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include "sched_config.h"
+
+// Clock functions the scheduler holds, overridable in
+// sched_config.h
+#ifndef SCHED_CLOCKS
+#define SCHED_CLOCKS	4
+#endif
+
+#define SCHED_EVENTS	16
+
+typedef void (*schedHandler)(void);
+typedef uint16_t (*schedClockFn)(void);
+
+// Function prototypes
+void initSched();
+void schedOn(uint8_t ev, schedHandler fn);
+void schedPost(uint8_t ev);
+int schedClock(schedClockFn fn);
+void schedRun();
+
+#endif /* SCHED_H_ */
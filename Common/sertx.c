@@ -0,0 +1,166 @@
+/*************************************************************
+ * File:	sertx.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Timer clocked bit serial output.  See
+ * 	sertx.h.
+ ************************************************************/
+
+#include "sertx.h"
+
+#if SERTX_HALF < 80
+#error "SERTX_BAUD is too fast for the interrupt at MCLK_HZ"
+#endif
+#if SERTX_HALF > 0x10000
+#error "SERTX_BAUD is too slow for Timer0_A at MCLK_HZ"
+#endif
+
+#ifdef SERTX_MANCHESTER
+#define SERTX_PINS		SERTX_DATA
+#else
+#define SERTX_PINS		(SERTX_DATA + SERTX_CLK)
+#endif
+
+// Frame buffers.  sertxSend() fills the one the interrupt is
+// not sending and hands it over by setting pending.
+static uint8_t frames[2][SERTX_FRAME];
+static uint16_t lens[2];					// bits
+static volatile uint8_t cur = 0;			// frame going out
+static volatile uint8_t pending = 0;		// other frame is ready
+
+// Bit engine state, interrupt only
+static const uint8_t *next;					// byte holding the next bit
+static uint8_t mask;						// next bit in that byte
+static uint16_t left = 0;					// bits to go in this frame
+static uint8_t half = 0;					// 1 on the second half of a bit
+#ifdef SERTX_MANCHESTER
+static uint8_t start = 0;					// start bit still to go
+#endif
+
+
+/* initSertx()
+ * 	Idle both lines low and stop the timer.
+ */
+void initSertx(){
+	P1OUT &=~ SERTX_PINS;
+	P1DIR |= SERTX_PINS;
+	TA0CTL = MC_0;
+	TA0CCTL0 = 0;
+	TA0CCR0 = SERTX_HALF - 1;
+	cur = 0;
+	pending = 0;
+	left = 0;
+	half = 0;
+} // end initSertx()
+
+
+/* sertxSend()
+ * 	Queue a frame.  Returns at once.
+ * @param: buf - frame, MSB of buf[0] first, copied
+ * @param: bits - frame length, 1 to 8 * SERTX_FRAME
+ * @return: 1 if queued, 0 if a frame is already waiting
+ * 		behind the one going out or the frame is too long
+ */
+int sertxSend(const uint8_t *buf, uint16_t bits){
+	uint8_t i, n, *f;
+
+	if(pending || bits == 0 || bits > 8 * SERTX_FRAME){
+		return 0;
+	}
+	f = frames[cur ^ 1];
+	n = (bits + 7) >> 3;
+	for(i = 0; i < n; i++){
+		f[i] = buf[i];
+	}
+	lens[cur ^ 1] = bits;
+	pending = 1;
+	if(!(TA0CCTL0 & CCIE)){
+		TA0CCTL0 = CCIE;
+		TA0CTL = TASSEL_2 + MC_1 + TACLR;	// SMCLK, up mode
+	}
+	return 1;
+} // end sertxSend()
+
+
+/* sertxIdle()
+ * @return: 1 once every queued bit is out and the timer has
+ * 		stopped
+ */
+uint8_t sertxIdle(){
+	return !(TA0CCTL0 & CCIE);
+} // end sertxIdle()
+
+
+/* sertxClock()
+ * @return: deepest LPM the driver allows, for the scheduler
+ */
+uint16_t sertxClock(){
+	return sertxIdle() ? LPM4_bits : LPM0_bits;
+} // end sertxClock()
+
+
+// Timer0_A CCR0 interrupt service routine, once per half bit
+#pragma vector=TIMER0_A0_VECTOR
+__interrupt void sertxTick(void){
+	uint8_t bit;
+
+	if(half){
+		half = 0;
+#ifdef SERTX_MANCHESTER
+		P1OUT ^= SERTX_DATA;				// mid bit edge
+#else
+		P1OUT |= SERTX_CLK;					// receiver samples
+#endif
+		return;
+	}
+	if(left == 0){
+		if(!pending){
+			// all out, idle the lines and stop
+			P1OUT &=~ SERTX_PINS;
+			TA0CTL = MC_0;
+			TA0CCTL0 = 0;
+			__bic_SR_register_on_exit(LPM4_bits);	// wake main
+			return;
+		}
+		cur ^= 1;
+		next = frames[cur];
+		mask = 0x80;
+		left = lens[cur];
+		pending = 0;
+#ifdef SERTX_MANCHESTER
+		start = 1;
+#endif
+	}
+#ifdef SERTX_MANCHESTER
+	if(start){
+		start = 0;
+		bit = 0;
+	}
+	else
+#endif
+	{
+		bit = *next & mask;
+		mask >>= 1;
+		if(mask == 0){
+			mask = 0x80;
+			next++;
+		}
+		left--;
+	}
+#ifdef SERTX_MANCHESTER
+	if(bit){
+		P1OUT &=~ SERTX_DATA;				// 1 - low, then high
+	}
+	else{
+		P1OUT |= SERTX_DATA;				// 0 - high, then low
+	}
+#else
+	if(bit){
+		P1OUT = (P1OUT & ~SERTX_CLK) | SERTX_DATA;
+	}
+	else{
+		P1OUT &=~ (SERTX_CLK + SERTX_DATA);
+	}
+#endif
+	half = 1;
+} // end sertxTick()
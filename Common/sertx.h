@@ -0,0 +1,67 @@
+/*************************************************************
+ * File:	sertx.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Timer clocked bit serial output on two P1
+ * 	pins, such as the LaunchPad LEDs into a photodiode.
+ *
+ * 	sertxSend() copies a frame of any number of bits and
+ * 	returns.  Bits go out MSB first from the first byte,
+ * 	one per SERTX_BAUD period, from the Timer0_A CCR0
+ * 	interrupt at twice the bit rate.  Frames are double
+ * 	buffered: one more can be queued while one goes out, and
+ * 	it follows with no gap.
+ *
+ * 	Clocked mode: SERTX_DATA changes with SERTX_CLK low and
+ * 	the receiver samples it on the rising edge of SERTX_CLK.
+ *
+ * 	Manchester mode (SERTX_MANCHESTER): SERTX_DATA alone
+ * 	carries clock and data.  Each bit is low then high for a
+ * 	1, high then low for a 0, so every bit has an edge in
+ * 	the middle.  Each frame starts with a 0 bit so the
+ * 	receiver sees an edge off the idle low line to lock on.
+ *
+ * 	Both lines idle low.  Timer0_A runs from SMCLK, so
+ * 	callers must not sleep deeper than LPM0 until
+ * 	sertxIdle(); sertxClock() says so to the scheduler.  The
+ * 	driver owns Timer0_A and TIMER0_A0_VECTOR.
+ *
+ * 	Each lab provides a sertx_config.h on its include path.
+ ************************************************************/
+
+#ifndef SERTX_H_
+#define SERTX_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include "sertx_config.h"
+
+// Pins on P1, overridable in sertx_config.h
+#ifndef SERTX_DATA
+#define SERTX_DATA		BIT0	// red LED
+#endif
+#ifndef SERTX_CLK
+#define SERTX_CLK		BIT6	// green LED, unused in Manchester mode
+#endif
+
+// Longest frame in bytes, overridable in sertx_config.h
+#ifndef SERTX_FRAME
+#define SERTX_FRAME		16
+#endif
+
+/* Timing.  MCLK_HZ declares the MCLK the lab runs at, with
+ * SMCLK = MCLK.  SERTX_BAUD is the bit rate.
+ */
+#if !defined(MCLK_HZ) || !defined(SERTX_BAUD)
+#error "sertx_config.h must declare MCLK_HZ and SERTX_BAUD"
+#endif
+
+#define SERTX_HALF		(MCLK_HZ / (2UL * SERTX_BAUD))	// SMCLK cycles per half bit
+
+// Function prototypes
+void initSertx();
+int sertxSend(const uint8_t *buf, uint16_t bits);
+uint8_t sertxIdle();
+uint16_t sertxClock();
+
+#endif /* SERTX_H_ */
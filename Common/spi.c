@@ -0,0 +1,163 @@
+/*************************************************************
+ * File:	spi.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Interrupt driven USCI_A0 SPI output.  See
+ * 	spi.h.
+ ************************************************************/
+
+#include "spi.h"
+#ifdef SPI_EVENT
+#include "sched.h"
+#endif
+
+#if SPI_QUEUE & (SPI_QUEUE - 1) || SPI_QUEUE < 8
+#error "SPI_QUEUE must be a power of two, 8 or more"
+#endif
+#if SPI_WAIT_SHORT < 8 * SPI_BR + 16
+#error "SPI_WAIT_SHORT must cover a byte on the wire and the ISR"
+#endif
+#if SPI_WAIT_LONG > 0x7FFF
+#error "SPI_WAIT_LONG is too long for Timer0_A at MCLK_HZ"
+#endif
+
+#define NEXT(i)		(((i) + 1) & (SPI_QUEUE - 1))
+#define TAG_SET(bits, i, on)	((on) ? ((bits)[(i) >> 3] |= 1 << ((i) & 7)) \
+									  : ((bits)[(i) >> 3] &=~ (1 << ((i) & 7))))
+#define TAG_GET(bits, i)		((bits)[(i) >> 3] & (1 << ((i) & 7)))
+
+// Queue.  spiPut() only moves head, the ISR only moves tail.
+// The tags of each byte are packed into rsBits and longBits.
+static uint8_t queue[SPI_QUEUE];
+static uint8_t rsBits[SPI_QUEUE / 8];
+static uint8_t longBits[SPI_QUEUE / 8];
+static volatile uint8_t head = 0;
+static volatile uint8_t tail = 0;
+
+
+/* initSPI()
+ *  Initialize USCI_A0 as a 3-pin SPI master, idle the
+ *  control lines and free-run Timer0_A for the deadlines.
+ */
+void initSPI(){
+	P1OUT |= SPI_CS;						// not talking
+	P1OUT &=~ SPI_RS;
+	P1DIR |= SPI_RS + SPI_CS;				// RS and CS are output
+	P1SEL |= BIT1 + BIT2 + BIT4;
+	P1SEL2 |= BIT1 + BIT2 + BIT4;
+	UCA0CTL1 |= UCSWRST;
+	UCA0CTL0 |= UCCKPL + UCMSB + UCMST + UCSYNC;	// 3-pin, 8-bit SPI master
+	UCA0CTL1 |= UCSSEL_2;					// SMCLK
+	UCA0BR0 = SPI_BR & 0xFF;
+	UCA0BR1 = SPI_BR >> 8;
+	UCA0MCTL = 0;							// No modulation
+	UCA0CTL1 &= ~UCSWRST;					// **Initialize USCI state machine**
+
+	TA0CCTL0 = 0;
+	TA0CTL = TASSEL_2 + MC_2 + TACLR;		// SMCLK, continuous mode
+} // end initSPI()
+
+
+/* spiStart()
+ * 	Assert CS and fire the pacing interrupt if it has
+ * 	stopped.  CS then stays low until the queue runs dry, so
+ * 	bytes queued back to back go out in one burst.
+ */
+static void spiStart(){
+	if(!(TA0CCTL0 & CCIE)){
+		P1OUT &=~ SPI_CS;					// CS low, signal slave to listen
+		TA0CCTL0 = CCIE + CCIFG;			// first byte goes right away
+	}
+} // end spiStart()
+
+
+/* spiPut()
+ * 	Queue one byte.
+ * @param: byte - value to send
+ * @param: tag - SPI_CMD or SPI_DATA, plus SPI_LONG
+ * @return: 1 if queued, 0 if the queue is full
+ */
+int spiPut(uint8_t byte, uint8_t tag){
+	return spiWrite(&byte, 1, tag);
+} // end spiPut()
+
+
+/* spiWrite()
+ * 	Queue a run of bytes that share one tag.  The run is
+ * 	published to the ISR in one go.
+ * @param: buf - bytes to send, copied into the queue
+ * @param: len - number of bytes
+ * @param: tag - SPI_CMD or SPI_DATA, plus SPI_LONG
+ * @return: 1 if queued, 0 if the run does not fit
+ */
+int spiWrite(const uint8_t *buf, uint8_t len, uint8_t tag){
+	uint8_t h = head;
+
+	if(len > spiFree()){
+		return 0;
+	}
+	while(len--){
+		queue[h] = *buf++;
+		TAG_SET(rsBits, h, tag & SPI_DATA);
+		TAG_SET(longBits, h, tag & SPI_LONG);
+		h = NEXT(h);
+	}
+	head = h;								// publish the whole run
+	spiStart();
+	return 1;
+} // end spiWrite()
+
+
+/* spiFree()
+ * @return: bytes that can be queued without spiPut() failing
+ */
+uint8_t spiFree(){
+	return (tail - head - 1) & (SPI_QUEUE - 1);
+} // end spiFree()
+
+
+/* spiIdle()
+ * @return: 1 once every queued byte is out, the slave has
+ * 		had its time with the last one and CS is high
+ */
+uint8_t spiIdle(){
+	return !(TA0CCTL0 & CCIE);
+} // end spiIdle()
+
+
+/* spiClock()
+ * @return: deepest LPM the driver allows, for the scheduler
+ */
+uint16_t spiClock(){
+	return spiIdle() ? LPM4_bits : LPM0_bits;
+} // end spiClock()
+
+
+// Timer0_A CCR0 interrupt service routine, one byte per deadline
+#pragma vector=TIMER0_A0_VECTOR
+__interrupt void spiTx(void){
+	uint8_t t = tail;
+
+	if(t == head){
+		// the slave is done with the last byte
+		P1OUT |= SPI_CS;					// CS high, we are done talking
+		TA0CCTL0 = 0;
+#ifdef SPI_EVENT
+		schedPost(SPI_EVENT);
+#endif
+		__bic_SR_register_on_exit(LPM4_bits);	// wake main
+		return;
+	}
+	// the wait covers the last byte on the wire, so RS can move
+	if(TAG_GET(rsBits, t)){
+		P1OUT |= SPI_RS;					// Select LCD data register
+	}
+	else{
+		P1OUT &=~ SPI_RS;					// Select LCD instruction register
+	}
+	UCA0TXBUF = queue[t];					// Load data into buffer
+	// next deadline runs from now, not the last deadline, so a
+	// late interrupt never shortens the slave's time
+	TA0CCR0 = TA0R + (TAG_GET(longBits, t) ? SPI_WAIT_LONG : SPI_WAIT_SHORT);
+	tail = NEXT(t);
+} // end spiTx()
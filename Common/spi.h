@@ -0,0 +1,88 @@
+/*************************************************************
+ * File:	spi.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Interrupt driven USCI_A0 SPI output for
+ * 	write-only peripherals with a register select line, such
+ * 	as the Lab5 LCD.
+ *
+ * 	spiPut() queues a byte and returns; spiWrite() queues a
+ * 	whole run.  Each byte is tagged with its RS level and how
+ * 	long the slave needs to act on it: SPI_WAIT_SHORT, or
+ * 	SPI_WAIT_LONG if tagged SPI_LONG.
+ *
+ * 	Bytes are paced by Timer0_A CCR0.  Its interrupt loads
+ * 	the next byte and sets the next deadline one wait after
+ * 	the byte started, so the next byte shifts out while the
+ * 	slave is still busy and lands as soon as it may.  CS
+ * 	falls once for the first byte and rises once the queue
+ * 	runs dry, and RS only moves where the level changes, so
+ * 	the caller is free while a whole screen streams out.
+ *
+ * 	USCI_A0 and Timer0_A run from SMCLK, so callers must not
+ * 	sleep deeper than LPM0 until spiIdle(); spiClock() says
+ * 	so to the scheduler.  Defining SPI_EVENT in spi_config.h
+ * 	posts that scheduler event each time the queue runs dry.
+ * 	The driver owns TIMER0_A0_VECTOR.
+ *
+ * 	Each lab provides a spi_config.h on its include path.
+ ************************************************************/
+
+#ifndef SPI_H_
+#define SPI_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include "spi_config.h"
+
+// Control lines on P1, overridable in spi_config.h
+#ifndef SPI_CS
+#define SPI_CS			BIT6	// 0 - slave listening
+#endif
+#ifndef SPI_RS
+#define SPI_RS			BIT7	// 0 - command, 1 - data
+#endif
+
+// SMCLK divider, overridable in spi_config.h
+#ifndef SPI_BR
+#define SPI_BR			2
+#endif
+
+// Queue length in bytes, overridable in spi_config.h
+#ifndef SPI_QUEUE
+#define SPI_QUEUE		64		// power of two, holds one less
+#endif
+
+/* Timing.  MCLK_HZ declares the MCLK the lab runs at, with
+ * SMCLK = MCLK.  SPI_WAIT_SHORT_NS and SPI_WAIT_LONG_NS are
+ * the slave's execution times, from the start of one byte
+ * to the start of the next.
+ */
+#ifndef MCLK_HZ
+#error "spi_config.h must declare MCLK_HZ"
+#endif
+#if !defined(SPI_WAIT_SHORT_NS) || !defined(SPI_WAIT_LONG_NS)
+#error "spi_config.h must declare SPI_WAIT_SHORT_NS and SPI_WAIT_LONG_NS"
+#endif
+
+// SMCLK cycles covering ns nanoseconds, rounded up.  MCLK_HZ
+// must be whole MHz; waits run to milliseconds, so this keeps
+// the product inside 32 bits.
+#define SPI_NS_CYCLES(ns)	(((ns) * (MCLK_HZ / 1000000UL) + 999UL) / 1000UL)
+#define SPI_WAIT_SHORT	SPI_NS_CYCLES(SPI_WAIT_SHORT_NS)
+#define SPI_WAIT_LONG	SPI_NS_CYCLES(SPI_WAIT_LONG_NS)
+
+// Byte tags
+#define SPI_CMD			0x00	// RS low
+#define SPI_DATA		0x01	// RS high
+#define SPI_LONG		0x02	// slave needs SPI_WAIT_LONG after this byte
+
+// Function prototypes
+void initSPI();
+int spiPut(uint8_t byte, uint8_t tag);
+int spiWrite(const uint8_t *buf, uint8_t len, uint8_t tag);
+uint8_t spiFree();
+uint8_t spiIdle();
+uint16_t spiClock();
+
+#endif /* SPI_H_ */
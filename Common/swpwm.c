@@ -0,0 +1,168 @@
+/*************************************************************
+ * File:	swpwm.c
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Software PWM from one Timer0_A compare.  See
+ * 	swpwm.h.
+ ************************************************************/
+
+#include "swpwm.h"
+
+#if SWPWM_CHANNELS < 1 || SWPWM_CHANNELS > 8
+#error "SWPWM_CHANNELS must be 1 to 8"
+#endif
+
+// Fall edges of one period, sorted by time
+typedef struct {
+	uint16_t at[SWPWM_CHANNELS];	// TA0R count of each edge
+	uint8_t mask[SWPWM_CHANNELS];	// pins that fall there
+	uint8_t n;						// edges in use
+	uint8_t on;						// pins that rise at the period start
+} edgeList;
+
+// Module variables
+static const uint8_t pins[SWPWM_CHANNELS] = SWPWM_PINS;
+static uint16_t duty[SWPWM_CHANNELS];
+static edgeList lists[2];
+static volatile uint8_t live = 0;			// list the interrupt runs
+static volatile uint8_t swap = 0;			// other list is newer
+static uint8_t edge = 0;					// next edge, n for the period start
+static uint16_t busy = 0;					// counts spent this period
+static volatile uint16_t isrMax = 0;
+static volatile uint16_t loadMax = 0;
+
+
+/* initSWPWM()
+ * 	Drive every channel low and arm CCR2 for the next
+ * 	period start.  Timer0_A must already be running.
+ */
+void initSWPWM(){
+	uint8_t ch, all = 0;
+
+	for(ch = 0; ch < SWPWM_CHANNELS; ch++){
+		all |= pins[ch];
+		duty[ch] = 0;
+	}
+	P1OUT &=~ all;
+	P1DIR |= all;
+	lists[0].n = 0;
+	lists[0].on = 0;
+	live = 0;
+	swap = 0;
+	edge = 0;
+	TA0CCR2 = 0;
+	TA0CCTL2 = CCIE;
+} // end initSWPWM()
+
+
+/* swpwmSet()
+ * 	Change a channel's duty and sort a new edge list.  The
+ * 	interrupt takes it from the next period start.
+ * @param: ch - channel
+ * @param: d - high time in timer counts, 0 for always low.
+ * 		Within SWPWM_GAP of the period end is always high, so
+ * 		the last fall never crowds the period start.
+ */
+void swpwmSet(uint8_t ch, uint16_t d){
+	edgeList *l;
+	uint16_t top = TA0CCR0 - SWPWM_GAP;
+	uint8_t i, j, k, n;
+
+	if(duty[ch] == d){
+		return;
+	}
+	duty[ch] = d;
+	swap = 0;								// live list stays put while we build
+	l = &lists[live ^ 1];
+	l->on = 0;
+	n = 0;
+	for(i = 0; i < SWPWM_CHANNELS; i++){
+		d = duty[i];
+		if(d == 0){
+			continue;
+		}
+		l->on |= pins[i];
+		if(d > top){
+			continue;						// never falls
+		}
+		// insertion sort, equal times share an edge
+		for(j = 0; j < n && l->at[j] < d; j++);
+		if(j < n && l->at[j] == d){
+			l->mask[j] |= pins[i];
+			continue;
+		}
+		for(k = n; k > j; k--){
+			l->at[k] = l->at[k - 1];
+			l->mask[k] = l->mask[k - 1];
+		}
+		l->at[j] = d;
+		l->mask[j] = pins[i];
+		n++;
+	}
+	l->n = n;
+	swap = 1;
+} // end swpwmSet()
+
+
+/* swpwmIsrMax()
+ * @return: longest single interrupt so far, timer counts
+ */
+uint16_t swpwmIsrMax(){
+	return isrMax;
+} // end swpwmIsrMax()
+
+
+/* swpwmLoadMax()
+ * @return: most interrupt time spent in one period so far,
+ * 		timer counts
+ */
+uint16_t swpwmLoadMax(){
+	return loadMax;
+} // end swpwmLoadMax()
+
+
+// Timer0_A CCR1/CCR2/TAIFG interrupt service routine, one
+// edge per interrupt plus any edges close behind it
+#pragma vector=TIMER0_A1_VECTOR
+__interrupt void swpwmEdge(void){
+	uint16_t start = TA0R;
+	uint16_t end;
+	edgeList *l = &lists[live];
+
+	if(TA0IV != TA0IV_TACCR2){
+		return;
+	}
+	if(edge < l->n){
+		P1OUT &=~ l->mask[edge];			// fall
+		edge++;
+	}
+	else{
+		if(swap){
+			live ^= 1;
+			swap = 0;
+			l = &lists[live];
+		}
+		P1OUT |= l->on;						// period start, rise
+		edge = 0;
+		if(busy > loadMax){
+			loadMax = busy;
+		}
+		busy = 0;
+	}
+	// edges too close behind for an interrupt of their own
+	while(edge < l->n && (int16_t)(l->at[edge] - TA0R) < SWPWM_GAP){
+		while((int16_t)(l->at[edge] - TA0R) > 0);
+		P1OUT &=~ l->mask[edge];
+		edge++;
+	}
+	TA0CCR2 = edge < l->n ? l->at[edge] : 0;
+
+	end = TA0R - start;
+	if(end > TA0CCR0){
+		end += TA0CCR0 + 1;					// TA0R wrapped at the period end
+	}
+	busy += end;
+	if(end > isrMax){
+		isrMax = end;
+	}
+} // end swpwmEdge()
@@ -0,0 +1,61 @@
+/*************************************************************
+ * File:	swpwm.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Software PWM on plain P1 pins from one
+ * 	Timer0_A compare unit, for when every hardware output is
+ * 	taken.
+ *
+ * 	Every channel rises together at the start of the Timer0_A
+ * 	period and falls at its own duty count.  The fall times
+ * 	are kept as an edge list, sorted, with channels of equal
+ * 	duty sharing an edge.  CCR2 is set to the next edge from
+ * 	the interrupt, so a period takes at most one interrupt
+ * 	per distinct duty plus one for the rise.  Edges closer
+ * 	than SWPWM_GAP are taken inside the interrupt before, by
+ * 	spinning on TA0R, rather than risking a missed compare.
+ *
+ * 	swpwmSet() sorts a new edge list only when a duty
+ * 	changes, into a second list the interrupt swaps in at
+ * 	the next period start, so a period never mixes old and
+ * 	new duties.
+ *
+ * 	Interrupt time is measured on TA0R: the longest single
+ * 	interrupt and the most counts spent in one period.  By
+ * 	construction one interrupt spins at most
+ * 	SWPWM_CHANNELS * SWPWM_GAP counts.
+ *
+ * 	Timer0_A must run in up mode, the caller sets the period
+ * 	in TA0CCR0.  The driver owns CCR2 and TIMER0_A1_VECTOR.
+ *
+ * 	Each lab provides a swpwm_config.h on its include path.
+ ************************************************************/
+
+#ifndef SWPWM_H_
+#define SWPWM_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include "swpwm_config.h"
+
+/* swpwm_config.h declares SWPWM_CHANNELS and SWPWM_PINS, one
+ * P1 bit per channel.
+ */
+#if !defined(SWPWM_CHANNELS) || !defined(SWPWM_PINS)
+#error "swpwm_config.h must declare SWPWM_CHANNELS and SWPWM_PINS"
+#endif
+
+// Closest edges that each get their own interrupt, in timer
+// counts.  Covers interrupt entry, the handler and exit with
+// margin; overridable in swpwm_config.h
+#ifndef SWPWM_GAP
+#define SWPWM_GAP		60
+#endif
+
+// Function prototypes
+void initSWPWM();
+void swpwmSet(uint8_t ch, uint16_t duty);
+uint16_t swpwmIsrMax();
+uint16_t swpwmLoadMax();
+
+#endif /* SWPWM_H_ */
@@ -64,6 +64,10 @@
 
 #include <msp430.h>
 
+#define BLINK	1800						// ~150 ms at VLO, about the old delay loop
+
+volatile unsigned char pressed = 0;			// button state, set by Port_1
+
 int main(void)
 {
   WDTCTL = WDTPW + WDTHOLD;                 // Stop watchdog timer
@@ -74,9 +78,31 @@ int main(void)
 
   P1REN |= BIT3;							// enable pullup resistor for BIT3 (push button S2)
 //  P1IN = BIT3;								// input is high (1)
-  P1IE |= BIT3;								// enable P1.3 interrupt
+  BCSCTL3 |= LFXT1S_2;						// ACLK = VLO
+  TA0CCR0 = BLINK;							// blink step
+  TA0CCTL0 = CCIE;
+
+  P1IES |= BIT3;							// wait for the press
   P1IFG &=~ BIT3;							// P1.3 clear IFG
-  __bis_SR_register(LPM4_bits + GIE);       // Enter LPM0 w/ interrupt
+  P1IE |= BIT3;								// enable P1.3 interrupt
+
+  for(;;)
+  {
+	  // apply the button state with interrupts off, so an edge
+	  // after the read still wakes the sleep below
+	  __disable_interrupt();
+	  if(pressed)
+	  {
+		  TA0CTL = TASSEL_1 + MC_1 + TACLR;	// ACLK, up mode
+	  }
+	  else
+	  {
+		  TA0CTL = MC_0;					// stop blinking
+		  P1OUT &=~ (BIT0 + BIT6);			// Turn off LEDs
+	  }
+	  // sleep until the button changes, the blink runs from ACLK
+	  __bis_SR_register(LPM3_bits + GIE);
+  }
 
 
 
@@ -94,19 +120,28 @@ int main(void)
   }*/
 } // end main
 
-// Timer A0 interrupt service routine
+// Pushbutton interrupt service routine.  Only records the button
+// state and arms the opposite edge; main does the rest.
 #pragma vector=PORT1_VECTOR
 __interrupt void Port_1 (void)
 {
-	volatile unsigned int i;
-	while(!(P1IN & BIT3))
+	if(P1IN & BIT3)
+	{
+		pressed = 0;
+		P1IES |= BIT3;						// wait for the press
+	}
+	else
 	{
-		P1OUT ^= (BIT0 + BIT6); // P1.0 = toggle
-		i = 50000;
-		do(i--);
-		while(i != 0);
+		pressed = 1;
+		P1IES &=~ BIT3;						// wait for the release
 	}
-	P1OUT &=~ (BIT0 + BIT6);
-	P1IFG &= ~BIT3; // P1.3 IFG cleared
-	P1IES ^= BIT3;	// toggle the interrupt edge
+	P1IFG &= ~BIT3; 						// P1.3 IFG cleared
+	__bic_SR_register_on_exit(LPM3_bits);	// wake main
+}
+
+// Timer A0 interrupt service routine, one blink step
+#pragma vector=TIMER0_A0_VECTOR
+__interrupt void Timer_A (void)
+{
+	P1OUT ^= (BIT0 + BIT6); 				// Toggle LEDs
 }
@@ -66,13 +66,47 @@
  *	File:	main.c
  *	Author:	Ross Moon
  *	Description:	 As described in Lab1 Part 4:
- *	The LEDs will blink in sequence 00 01 10 11 until the button is
- *	pressed and then they will stop. This works similar to a 4 sided die.
- *	When you press the button again the LEDs continue to blink as before.
+ *	A 4 sided die.  Each press of the button rolls it and the LEDs show
+ *	the face, 00 01 10 11, until the next press.
+ *
+ *	The CPU sleeps in LPM3 between presses with Timer_A1 counting the VLO.
+ *	A press captures Timer_A1, so the roll depends on the time between
+ *	presses to the VLO tick.  Main then times a few VLO periods against
+ *	the DCO with Timer_A0, whose low bits come from the jitter between the
+ *	two oscillators, and mixes both into the die state with a xorshift.
+ *
+ *	The capture is of the VLO, ~12 kHz, not a fast timer: SMCLK is off in
+ *	LPM3, so nothing faster can run free between presses.  That is still
+ *	plenty per press.  Nobody times a press to better than tens of
+ *	milliseconds, hundreds of 83 us ticks, so the low several bits of the
+ *	capture are unpredictable, and a face needs only two.  The DCO jitter
+ *	then covers the case of no button at all.
+ *
+ *	Define DIE_SELFTEST to build a statistical check instead: DIE_ROLLS
+ *	rolls with no button, so only the oscillator jitter is random, then
+ *	chi-square tests on the faces and on pairs of faces and a bias test
+ *	on the raw jitter.  P1.6 lights if every test passes, P1.0 if any
+ *	fails.
  */
 
 #include <msp430.h>
 
+//#define DIE_SELFTEST
+
+#define JITTER_SAMPLES	8					// VLO periods timed per roll
+#define DIE_ROLLS		4096				// rolls in the self-test
+
+volatile unsigned char pressed = 0;			// button state, set by Port_1
+volatile unsigned int press;				// Timer_A1 at the last press
+unsigned int seed = 1;						// die state, never 0
+
+unsigned int vloJitter(void);
+unsigned char roll(unsigned int capture);
+void showFace(unsigned char face);
+#ifdef DIE_SELFTEST
+void selfTest(void);
+#endif
+
 int main(void)
 {
   WDTCTL = WDTPW + WDTHOLD;                 // Stop watchdog timer
@@ -82,53 +116,185 @@ int main(void)
   P1OUT |= BIT3;							// Activate pushbutton S2
 
   P1REN |= BIT3;							// enable pullup resistor for BIT3 (push button S2)
-  P1IE |= BIT3;								// enable P1.3 interrupt
-  P1IFG &=~ BIT3;							// P1.3 clear IFG
-
-  int R4 = 0;
-
-  __bis_SR_register(GIE);       			// Enable interrupt
-
+  BCSCTL3 |= LFXT1S_2;						// ACLK = VLO
+  TA1CCTL0 = CM_3 + CCIS_2 + CAP;			// capture on CCIS toggles, from GND,
+											// at once rather than on the next VLO edge
+  TA1CTL = TASSEL_1 + MC_2 + TACLR;			// ACLK, continuous mode
 
-  volatile unsigned int i;
+#ifdef DIE_SELFTEST
+  selfTest();
   for(;;)
   {
-	  P1OUT &=~ (BIT0 + BIT6);				// Turn off LEDs
+	  __bis_SR_register(LPM4_bits);			// done, result on the LEDs
+  }
+#else
+  P1IES |= BIT3;							// wait for the press
+  P1IFG &=~ BIT3;							// P1.3 clear IFG
+  P1IE |= BIT3;								// enable P1.3 interrupt
 
-	  if(R4 > 3)
-	  {
-		  // Reset the count to 0
-		  R4 = 0;
-	  }
-	  if(R4 == 1 || R4 == 3)
-	  {
-		  // Enable left LED
-		  P1OUT |= BIT6;
-	  }
-	  if(R4 == 2 || R4 == 3)
+  for(;;)
+  {
+	  // roll with interrupts off, so an edge after the read
+	  // still wakes the sleep below
+	  __disable_interrupt();
+	  if(pressed)
 	  {
-		  // Enable right LED
-		  P1OUT |= BIT0;
+		  showFace(roll(press));
 	  }
-
-	  // Delay operation
-	  i = 500;
-	  do(i--);
-	  while(i != 0);
-	  R4++;									// Increment R4;
+	  // sleep until the button changes, Timer_A1 runs from ACLK
+	  __bis_SR_register(LPM3_bits + GIE);
   }
+#endif
 
 } // end main
 
-// Pushbutton interrupt service routine
+/* vloJitter()
+ * 	Time JITTER_SAMPLES VLO periods in DCO cycles with Timer_A0
+ * 	capturing ACLK, folding each period into the result.
+ * 	@return: mixed periods, the low bits carry the jitter
+ */
+unsigned int vloJitter(void)
+{
+	unsigned int last, now, mix = 0;
+	unsigned char i;
+
+	TA0CCTL0 = CM_1 + CCIS_1 + SCS + CAP;	// capture ACLK rising edges (CCI0B)
+	TA0CTL = TASSEL_2 + MC_2 + TACLR;		// SMCLK, continuous mode
+	while(!(TA0CCTL0 & CCIFG));
+	TA0CCTL0 &=~ CCIFG;
+	last = TA0CCR0;
+	for(i = 0; i < JITTER_SAMPLES; i++)
+	{
+		while(!(TA0CCTL0 & CCIFG));
+		TA0CCTL0 &=~ CCIFG;
+		now = TA0CCR0;
+		mix = ((mix << 3) | (mix >> 13)) ^ (now - last);
+		last = now;
+	}
+	TA0CTL = MC_0;							// stop SMCLK use
+	TA0CCTL0 = 0;
+	return mix;
+} // end vloJitter()
+
+/* roll()
+ * 	Mix a press capture and fresh jitter into the die state and
+ * 	take a face from it.
+ * 	@param: capture - Timer_A1 at the press
+ * 	@return: face, 0-3
+ */
+unsigned char roll(unsigned int capture)
+{
+	seed ^= capture;
+	seed ^= vloJitter();
+	if(seed == 0)
+	{
+		seed = 1;
+	}
+	// xorshift spreads every input bit over the whole state
+	seed ^= seed << 7;
+	seed ^= seed >> 9;
+	seed ^= seed << 8;
+	return (seed ^ (seed >> 8)) & 0x03;
+} // end roll()
+
+/* showFace()
+ * 	Show a face on the LEDs, as the old sequence did.
+ * 	@param: face - 0-3
+ */
+void showFace(unsigned char face)
+{
+	P1OUT &=~ (BIT0 + BIT6);				// Turn off LEDs
+	if(face & 0x01)
+	{
+		P1OUT |= BIT6;						// Enable left LED
+	}
+	if(face & 0x02)
+	{
+		P1OUT |= BIT0;						// Enable right LED
+	}
+} // end showFace()
+
+#ifdef DIE_SELFTEST
+/* selfTest()
+ * 	Roll DIE_ROLLS times with no button and run the tests, chi-square
+ * 	at 99% in whole numbers: the sum of (observed - expected)^2 must stay
+ * 	under the critical value times expected.
+ * 		faces:	3 degrees of freedom, 11.34
+ * 		pairs:	15 degrees of freedom, 30.58
+ * 		jitter:	low bit of the raw jitter within 4 sigma of half
+ */
+void selfTest(void)
+{
+	static unsigned int faces[4], pairs[16];
+	unsigned long sum;
+	unsigned int i, ones = 0, last = 0, face, expect;
+	int d;
+	unsigned char pass = 1;
+
+	for(i = 0; i < DIE_ROLLS; i++)
+	{
+		ones += vloJitter() & 0x01;
+		TA1CCTL0 ^= CCIS0;					// a simulated press
+		face = roll(TA1CCR0);
+		faces[face]++;
+		if(i & 0x01)
+		{
+			pairs[(last << 2) + face]++;
+		}
+		last = face;
+	}
+
+	expect = DIE_ROLLS / 4;
+	for(sum = 0, i = 0; i < 4; i++)
+	{
+		d = faces[i] - expect;
+		sum += (long)d * d;
+	}
+	if(sum > 1134UL * expect / 100)
+	{
+		pass = 0;
+	}
+
+	expect = DIE_ROLLS / 2 / 16;
+	for(sum = 0, i = 0; i < 16; i++)
+	{
+		d = pairs[i] - expect;
+		sum += (long)d * d;
+	}
+	if(sum > 3058UL * expect / 100)
+	{
+		pass = 0;
+	}
+
+	// sigma is sqrt(DIE_ROLLS) / 2, 32 for 4096 rolls
+	if(ones < DIE_ROLLS / 2 - 128 || ones > DIE_ROLLS / 2 + 128)
+	{
+		pass = 0;
+	}
+
+	P1OUT &=~ (BIT0 + BIT6);
+	P1OUT |= pass ? BIT6 : BIT0;
+} // end selfTest()
+#endif
+
+// Pushbutton interrupt service routine.  Records the button state,
+// captures Timer_A1 on a press and arms the opposite edge; main does
+// the rest.
 #pragma vector=PORT1_VECTOR
 __interrupt void Port_1 (void)
 {
-	// while the pushbutton is pressed do:
-	while(!(P1IN & BIT3))
+	if(P1IN & BIT3)
+	{
+		pressed = 0;
+		P1IES |= BIT3;						// wait for the press
+	}
+	else
 	{
-		// do nothing
+		TA1CCTL0 ^= CCIS0;					// capture Timer_A1 now
+		press = TA1CCR0;
+		pressed = 1;
+		P1IES &=~ BIT3;						// wait for the release
 	}
 	P1IFG &= ~BIT3; 						// P1.3 IFG cleared
-	P1IES ^= BIT3;							// Toggle the interrupt edge
+	__bic_SR_register_on_exit(LPM3_bits);	// wake main
 }
@@ -0,0 +1,18 @@
+/*************************************************************
+ * File:	sertx_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Serial LED output for this lab.  Data on the
+ * 	red LED (P1.0), clock on the green LED (P1.6), the
+ * 	sertx.h defaults.  MCLK = SMCLK runs from the calibrated
+ * 	DCO at MCLK_HZ.  Define SERTX_MANCHESTER to send on the
+ * 	red LED alone.
+ ************************************************************/
+
+#ifndef SERTX_CONFIG_H_
+#define SERTX_CONFIG_H_
+
+#define MCLK_HZ			8000000UL
+#define SERTX_BAUD		10000UL		// bits per second
+
+#endif /* SERTX_CONFIG_H_ */
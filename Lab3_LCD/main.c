@@ -6,69 +6,101 @@
  * 	Input is 4x4 keypad.  Output is binary signal send to red
  * 	LED on MSP430 launchPad.  Green LED is clock.  Keypad also
  * 	controls brightness of LCD display on key press of 0-9.
+ *
+ * 	Brightness keys pick one of 64 gamma corrected levels, so
+ * 	each key looks an even step brighter than the last.  The
+ * 	backlight fades to the new level over FADE_MS: once per
+ * 	PWM period, as TA1.1 is set, the TA1 CCR0 interrupt
+ * 	loads the duty cycle worked out the period before and
+ * 	then moves a fraction of a level along the curve.  A
+ * 	duty cycle too short for the load to beat, which TAR has
+ * 	already passed, has its pulse ended by hand, so no
+ * 	period glitches to full on.
  ************************************************************/
 
 // Library includes
 #include <msp430.h>
+#include "keypad.h"
 
 // Class constant variables
-#define CLK_SPD 37250	// ~4 Hz
+#define CLK_SPD 37250	// ~3.4 Hz
 #define PWM_VAL 22222
+#define SMCLK_HZ	1000000UL
+#define PWM_HZ		(SMCLK_HZ / (PWM_VAL + 1))	// ~45 Hz
+#define LEVELS		64		// brightness levels, 0 is off
+#define KEY_LEVELS	7		// levels per brightness key
+#define FADE_MS		300		// time to fade from one key to the next
+
+/* Gamma correction, worked out by the compiler.  Duty cycle
+ * follows (4x^2 + x^3) / 5 of the level, within a few
+ * percent of the x^2.2 eyes expect, and integer only.
+ */
+#define GAMMA(i)	((unsigned int)((unsigned long long)PWM_VAL * (i) * (i) \
+						* (4 * (LEVELS - 1) + (i)) \
+						/ (5ULL * (LEVELS - 1) * (LEVELS - 1) * (LEVELS - 1))))
+#define GAMMA8(i)	GAMMA(i), GAMMA(i + 1), GAMMA(i + 2), GAMMA(i + 3), \
+					GAMMA(i + 4), GAMMA(i + 5), GAMMA(i + 6), GAMMA(i + 7)
 
 // Function prototypes
 void initTimer();
 void initLEDs();
-void initKeypad();
 void initPWM();
 void modDuty(unsigned int index);
+void fadeTo(unsigned int level, unsigned int ms);
 
 // Class variables
-unsigned int haveInput = 0;	// 0 - false; 1 - true
-volatile int row, col, num;
+volatile unsigned int haveInput = 0;	// 0 - false; 1 - true
 volatile unsigned int displayVal;
 volatile unsigned int displayCount = 0;
-volatile unsigned int dutyCycle[] = {PWM_VAL * 0, PWM_VAL * .1, PWM_VAL * .2, PWM_VAL * .3,
-									PWM_VAL * .4, PWM_VAL * .5, PWM_VAL * .6, PWM_VAL * .7,
-									PWM_VAL * .8, PWM_VAL * .9};
-volatile unsigned int muxRow[] = {0x00, 0x08, 0x10, 0x18};	// Binary: 00, 01, 10, 11
-volatile unsigned int cols[] = {0x0D, 0x25, 0x29, 0x2C};
-volatile unsigned char dispKey[4][4] = {{0x01, 0x02, 0x03, 0x0A},	// 1, 2, 3, A -> 0001, 0010, 0011, 1010
-										{0x04, 0x05, 0x06, 0x0B},	// 4, 5, 6, B -> 0100, 0101, 0110, 1011
-										{0x07, 0x08, 0x09, 0x0C},	// 7, 8, 9, C -> 0111, 1000, 1001, 1100
-										{0x0E, 0x00, 0x0F, 0x0D}};	// *, 0, #, D -> 1110, 0000, 1111, 1101
+const unsigned int dutyCycle[LEVELS] = {GAMMA8(0), GAMMA8(8), GAMMA8(16), GAMMA8(24),
+									GAMMA8(32), GAMMA8(40), GAMMA8(48), GAMMA8(56)};
+
+// Fade state, positions are levels << 8
+volatile unsigned int fadePos;			// brightness going out next period
+unsigned int fadeDuty;					// and its TA1CCR1
+unsigned int fadeStep;					// whole steps per period
+unsigned int fadeRem;					// and the remainder, spread over the fade
+unsigned int fadeAcc;
+unsigned int fadeLeft;					// periods to go
+unsigned int fadeLen;					// periods in the fade
+unsigned char fadeDown;					// 1 if getting dimmer
 
 
 
 
 
 void main(void) {
+	unsigned char key;
 
 	// initialize hardware
 	WDTCTL = WDTPW + WDTHOLD;           // Stop watchdog timer
+
+	// Set both clocks to 1MHZ, the fade times are derived from it
+	BCSCTL1 = CALBC1_1MHZ;
+	DCOCTL = CALDCO_1MHZ;
+
    	initLEDs();
 	initKeypad();
 	initTimer();
 	initPWM();
-	__bis_SR_register(GIE);				// Enable interrupts
 
 	while(1){
-		if(!haveInput){
-			unsigned int i, j;
-			for (i = 0; i < 4; i ++){
-				// find row of pressed button
-				P1OUT |= muxRow[i];		// set P1OUT to current test
-				for (j = 0; j < 4; j ++) {
-					// find column of pressed button
-					if ((P2IN & 0xFF) == cols[j]){
-						// yay! we found the button
-						displayVal = dispKey[j][i];
-						modDuty(displayVal);
-						haveInput = 1;
-					}
-				}// end for(col)
-				P1OUT &=~ muxRow[i];	// reset P1OUT for next test
-			} // end for(row)
-		} // end if(!haveInput)
+		// TA1 PWM runs from SMCLK, so LPM0 is as deep as we go.
+		// The keypad wakes us once per key press; one queued
+		// since the last read skips the sleep.
+		__disable_interrupt();
+		if(keypadPending()){
+			__enable_interrupt();
+		}
+		else{
+			__bis_SR_register(LPM0_bits + GIE);
+		}
+		key = keypadGetKey();
+		if(!haveInput && key != KEY_NONE){
+			displayVal = keymap[key];
+			modDuty(displayVal);
+			haveInput = 1;
+		}
 	} // end while(1)
 
 } // end main()
@@ -107,17 +139,83 @@ __interrupt void Timer_A (void){
 } // end Timer_A0 interrupt
 
 /* modDuty()
- * 	Sets the percent duty cycle of the PWM on TA1
- * 	@param: index - index of the percent duty cycle
- * 		Declared in dutyCycle array.
+ * 	Fades the PWM on TA1 to the brightness for a key
+ * 	@param: index - brightness key, 0 (off) to 9 (full)
  */
 void modDuty(unsigned int index){
 	if(index < 0x0A){
-		// index is 0-9
-		TA1CCR1 = dutyCycle[index];		// 0% - 90% duty cycle
+		fadeTo(index * KEY_LEVELS, FADE_MS);
 	}
 }
 
+
+/* fadeTo()
+ * 	Start a fade from the brightness going out now.  Returns
+ * 	at once; a fade already running is replaced.
+ * 	@param: level - brightness, 0 to LEVELS - 1
+ * 	@param: ms - fade time
+ */
+void fadeTo(unsigned int level, unsigned int ms){
+	unsigned short state;
+	unsigned int target = level << 8;
+	unsigned int dist, len;
+
+	len = ((unsigned long)ms * PWM_HZ + 999) / 1000;
+	if(len == 0){
+		len = 1;
+	}
+	state = __get_interrupt_state();
+	__disable_interrupt();
+	fadeDown = target < fadePos;
+	dist = fadeDown ? fadePos - target : target - fadePos;
+	fadeStep = dist / len;
+	fadeRem = dist % len;
+	fadeAcc = 0;
+	fadeLen = len;
+	fadeLeft = len;
+	TA1CCTL0 = CCIE;
+	__set_interrupt_state(state);
+} // end fadeTo()
+
+
+// Timer A1 CCR0 interrupt service routine, once per PWM period
+// as the output is set
+#pragma vector=TIMER1_A0_VECTOR
+__interrupt void fadeTick(void){
+	unsigned int i, f, step;
+
+	TA1CCR1 = fadeDuty;
+	if(TA1R >= fadeDuty){
+		// TAR is already past it, reset the output by hand
+		TA1CCTL1 = OUTMOD_0;
+		TA1CCTL1 = OUTMOD_7;
+	}
+	if(fadeLeft == 0){
+		TA1CCTL0 = 0;						// there, stop ticking
+		return;
+	}
+	fadeLeft--;
+
+	step = fadeStep;
+	fadeAcc += fadeRem;
+	if(fadeAcc >= fadeLen){
+		fadeAcc -= fadeLen;
+		step++;
+	}
+	fadePos = fadeDown ? fadePos - step : fadePos + step;
+
+	// interpolate between table levels
+	i = fadePos >> 8;
+	f = fadePos & 0xFF;
+	if(i < LEVELS - 1){
+		fadeDuty = dutyCycle[i]
+				+ (((unsigned long)(dutyCycle[i + 1] - dutyCycle[i]) * f) >> 8);
+	}
+	else{
+		fadeDuty = dutyCycle[LEVELS - 1];
+	}
+} // end fadeTick()
+
 /* initTimer()
  * 	Initialize MSP430 timer interrupts
  */
@@ -141,19 +239,6 @@ void initLEDs(){
 } // end initLEDs()
 
 
-/* initKeypad()
- * 	Ports 1.3 and 1.4 strobe deMUX input.
- * 	Ports 2.0, 2.2, 2.3, 2.5 listen to deMUX output
- */
-void initKeypad(){
-	P1DIR |= (BIT3 + BIT4);					// Set as output ports
-	P1OUT &=~ (BIT3 + BIT4);				// Strobe ports are low by default
-
-	P2REN |= (BIT0 + BIT2 + BIT3 + BIT5);	// Enable resistors
-	P2DIR &=~ (BIT0 + BIT2 + BIT3 + BIT5);	// Enable input for keypad
-} // end initKeypad()
-
-
 /* initPWM()
  *	Initialize timers A1 for hardware PWM
  *	PWM signal output to 2.1
@@ -164,7 +249,9 @@ void initPWM(){
 	P2SEL |= BIT1;				// Enable PWM on 2.1
 
 	TA1CCR0 = PWM_VAL;         	// PWM period
-	TA1CCR1 = PWM_VAL / 2;      // PWM duty cycle, 50% initially
+	fadePos = (LEVELS / 2) << 8;
+	fadeDuty = dutyCycle[LEVELS / 2];
+	TA1CCR1 = fadeDuty;			// PWM duty cycle, half bright initially
 	TA1CCTL1 = OUTMOD_7;        // CCR1 reset/set
 	TA1CTL = TASSEL_2 + MC_1;   // SMCLK, up mode
 
@@ -5,6 +5,8 @@
  * Description:	Lab 3.2 - Controls 3 servos via PWM.
  * 	TA1.1 and TA1.2 each control continious rotation servos (A and B).
  * 	TA0 controls a potition servo.
+ * 	Software PWM on TA0 CCR2 controls two more position
+ * 	servos (C on P1.5, D on P1.7).  See swpwm.h.
  * 	Keypad Map:
  * 		1 - rotate position servo left while pressed
  * 		2- 	rotate both continuous servos left
@@ -12,13 +14,29 @@
  * 		4 - rotate servo A right and servo B left
  * 		5 - stop servos A and B
  * 		6 - rotate servo A left and servo B right
+ * 		7 - servo C to the left end
  * 		8 - rotate both continuous servos right
+ * 		9 - servo C to the right end
+ * 		A - servo D to the left end
+ * 		B - servo D to the right end
+ * 		C - center servos C and D
  * 		0 - center position servo
+ * 	Keys can be chorded, e.g. hold 2 to drive forward while
+ * 	holding 1 or 3 to jog the position servo.
+ *
+ * 	Keys only set targets.  The motion profiler ramps every
+ * 	servo toward its target once per PWM period, limited in
+ * 	speed and acceleration, so reversals ramp through STOP
+ * 	and the position servo moves at the same speed however
+ * 	busy main is.  See motion.h.
  *
  ************************************************************/
 
 // Library includes
 #include <msp430.h>
+#include "keypad.h"
+#include "motion.h"
+#include "swpwm.h"
 
 // Class constant variables
 #define PWM_PERIOD 	20000
@@ -29,27 +47,21 @@
 
 // Function prototypes
 void initLEDs();
-void initKeypad();
 void initPWM_TA0();
 void initPWM_TA1();
 void moveServos(unsigned int cmd);
+void stopServos(unsigned int cmd);
 
 // Class variables
 
 volatile unsigned int cmdVal;
-volatile int row, col, num;
-volatile unsigned int muxRow[] = {0x00, 0x08, 0x10, 0x18};	// Binary: 00, 01, 10, 11
-volatile unsigned int cols[] = {0x0D, 0x25, 0x29, 0x2C};
-volatile unsigned char commands[4][4] = {{0x01, 0x02, 0x03, 0x0A},	// 1, 2, 3, A -> 0001, 0010, 0011, 1010
-										{0x04, 0x05, 0x06, 0x0B},	// 4, 5, 6, B -> 0100, 0101, 0110, 1011
-										{0x07, 0x08, 0x09, 0x0C},	// 7, 8, 9, C -> 0111, 1000, 1001, 1100
-										{0x0E, 0x00, 0x0F, 0x0D}};	// *, 0, #, D -> 1110, 0000, 1111, 1101
 
 
 
 
 
 void main(void) {
+	keyEvent ev;
 
 	WDTCTL = WDTPW + WDTHOLD;           // Stop watchdog timer
 
@@ -60,68 +72,105 @@ void main(void) {
 	// Initialize ports & hardware
 	initLEDs();
 	initKeypad();
-	initPWM_TA0();
-	initPWM_TA1();
-
-	__bis_SR_register(GIE);				// Enable interrupts
+	initPWM_TA0();						// back to back, so both
+	initPWM_TA1();						// periods start together
+	initMotion();
+	initSWPWM();
+	swpwmSet(SERVO_C, STOP);
+	swpwmSet(SERVO_D, STOP);
 
 	while(1){
-		unsigned int i, j;
-		for (i = 0; i < 4; i ++){
-			// find row of pressed button
-			P1OUT |= muxRow[i];		// set P1OUT to current test
-			for (j = 0; j < 4; j ++) {
-				// find column of pressed button
-				if ((P2IN & 0xFF) == cols[j]){
-					// yay! we found the button
-					cmdVal = commands[j][i];
-					moveServos(cmdVal);
-				}
-			}// end for(col)
-			P1OUT &=~ muxRow[i];	// reset P1OUT for next test
-		} // end for(row)
+		// PWM runs from SMCLK, so LPM0 is as deep as we go.  The
+		// keypad wakes us on a press and on a release; an event
+		// queued since the last read skips the sleep.
+		__disable_interrupt();
+		if(keypadPending()){
+			__enable_interrupt();
+		}
+		else{
+			__bis_SR_register(LPM0_bits + GIE);
+		}
+		while(keypadGetEvent(&ev)){
+			cmdVal = keymap[ev.key];
+			if(ev.type == KEY_PRESSED){
+				moveServos(cmdVal);
+			}
+			else if(ev.type == KEY_RELEASED){
+				stopServos(cmdVal);
+			}
+		}
 	} // end while(1)
 } // end main()
 
 
 
+/* moveServos()
+ * 	Set the servo targets for a key press.
+ * @param: cmd - key value
+ */
 void moveServos(unsigned int cmd){
 	switch(cmd){
 	case 0x00:
-		TA0CCR1 = STOP;
+		motionSetTarget(SERVO_POS, STOP);
 		break;
-	case 0x01:
-		if(TA0CCR1 < FORWARD)
-			TA0CCR1++;
+	case 0x01:		// toward the end until released
+		motionSetTarget(SERVO_POS, FORWARD);
 		break;
 	case 0x02:		// forward
-		TA1CCR1 = FORWARD;
- 		TA1CCR2 = FORWARD;
+		motionSetTarget(SERVO_A, FORWARD);
+		motionSetTarget(SERVO_B, FORWARD);
 		break;
-	case 0x03:
-		if(TA0CCR1 > BACKWARD)
-			TA0CCR1--;
+	case 0x03:		// toward the other end until released
+		motionSetTarget(SERVO_POS, BACKWARD);
 		break;
 	case 0x04:		// turn left
-		TA1CCR1 = BACKWARD;
-		TA1CCR2 = FORWARD;
+		motionSetTarget(SERVO_A, BACKWARD);
+		motionSetTarget(SERVO_B, FORWARD);
 		break;
 	case 0x05:		// stop
-		TA1CCR1 = STOP;
-		TA1CCR2 = STOP;
+		motionSetTarget(SERVO_A, STOP);
+		motionSetTarget(SERVO_B, STOP);
 		break;
 	case 0x06:		// turn right
-		TA1CCR1 = FORWARD;
-		TA1CCR2 = BACKWARD;
+		motionSetTarget(SERVO_A, FORWARD);
+		motionSetTarget(SERVO_B, BACKWARD);
+		break;
+	case 0x07:
+		swpwmSet(SERVO_C, FORWARD);
 		break;
 	case 0x08:		// reverse
-		TA1CCR1 = BACKWARD;
-		TA1CCR2 = BACKWARD;
+		motionSetTarget(SERVO_A, BACKWARD);
+		motionSetTarget(SERVO_B, BACKWARD);
+		break;
+	case 0x09:
+		swpwmSet(SERVO_C, BACKWARD);
+		break;
+	case 0x0A:
+		swpwmSet(SERVO_D, FORWARD);
+		break;
+	case 0x0B:
+		swpwmSet(SERVO_D, BACKWARD);
+		break;
+	case 0x0C:
+		swpwmSet(SERVO_C, STOP);
+		swpwmSet(SERVO_D, STOP);
 		break;
 	} // end switch
 } // end moveServos()
 
 
+/* stopServos()
+ * 	Stop the position servo where it is when its jog key is
+ * 	released.
+ * @param: cmd - key value
+ */
+void stopServos(unsigned int cmd){
+	if(cmd == 0x01 || cmd == 0x03){
+		motionStop(SERVO_POS);
+	}
+} // end stopServos()
+
+
 /* initLEDs()
  *  Enable LaunchPad LEDs: LED1 and LED2.
  *  LED1 = BIT0 = green LED
@@ -133,19 +182,6 @@ void initLEDs(){
 } // end initLEDs()
 
 
-/* initKeypad()
- * 	Ports 1.3 and 1.4 strobe deMUX input.
- * 	Ports 2.0, 2.2, 2.3, 2.5 listen to deMUX output
- */
-void initKeypad(){
-	P1DIR |= (BIT3 + BIT4);					// Set as output ports
-	P1OUT &=~ (BIT3 + BIT4);				// Strobe ports are low by default
-
-	P2REN |= (BIT0 + BIT2 + BIT3 + BIT5);	// Enable resistors
-	P2DIR &=~ (BIT0 + BIT2 + BIT3 + BIT5);	// Enable input for keypad
-} // end initKeypad()
-
-
 /* initPWM_TA0()
  * 	Initialize timer A0 for hardware PWM
  * 	PWM signal output to 1.6
@@ -157,7 +193,7 @@ void initPWM_TA0(){
 	TA0CCR0 = PWM_PERIOD;       // PWM period
 	TA0CCR1 = STOP;      		// PWM duty cycle,
 	TA0CCTL1 = OUTMOD_7;        // CCR1 reset/set
-	TA0CTL = TASSEL_2 + MC_1;   // SMCLK, up mode
+	TA0CTL = TASSEL_2 + MC_1 + TACLR;	// SMCLK, up mode
 
 } // end initPWM_TA1_TA0()
 
@@ -174,6 +210,6 @@ void initPWM_TA1(){
 	TA1CCR2 = STOP;				// PWM duty cycle for TA1.2
 	TA1CCTL1 = OUTMOD_7;        // reset/set for TA1.1
 	TA1CCTL2 = OUTMOD_7;		// reset/set for TA1.2
-	TA1CTL = TASSEL_2 + MC_1;   // SMCLK, up mode
+	TA1CTL = TASSEL_2 + MC_1 + TACLR;	// SMCLK, up mode
 
 }
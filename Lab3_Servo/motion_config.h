@@ -0,0 +1,25 @@
+/*************************************************************
+ * File:	motion_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Motion channels for this lab, in timer counts
+ * 	(1 us) per 20 ms period.  The position servo sweeps end
+ * 	to end in about a second.  The continuous servos ramp
+ * 	from STOP to full speed in about half a second, so a
+ * 	reversal takes about a second instead of one period.
+ ************************************************************/
+
+#ifndef MOTION_CONFIG_H_
+#define MOTION_CONFIG_H_
+
+#define MOTION_CHANNELS	3
+#define MOTION_CCR		{&TA0CCR1, &TA1CCR1, &TA1CCR2}
+#define MOTION_VMAX		{20, 25, 25}
+#define MOTION_AMAX		{1, 2, 2}
+
+// Channels
+#define SERVO_POS		0		// position servo, TA0.1
+#define SERVO_A			1		// continuous servo A, TA1.1
+#define SERVO_B			2		// continuous servo B, TA1.2
+
+#endif /* MOTION_CONFIG_H_ */
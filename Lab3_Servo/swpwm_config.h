@@ -0,0 +1,20 @@
+/*************************************************************
+ * File:	swpwm_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Software PWM channels for this lab, on the
+ * 	20 ms Timer0_A period: two more position servos on P1.5
+ * 	and P1.7.
+ ************************************************************/
+
+#ifndef SWPWM_CONFIG_H_
+#define SWPWM_CONFIG_H_
+
+#define SWPWM_CHANNELS	2
+#define SWPWM_PINS		{BIT5, BIT7}
+
+// Channels
+#define SERVO_C			0		// position servo, P1.5
+#define SERVO_D			1		// position servo, P1.7
+
+#endif /* SWPWM_CONFIG_H_ */
@@ -0,0 +1,24 @@
+/*************************************************************
+ * File:	i2c_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	I2C bus for this lab.  MCLK = SMCLK runs from
+ * 	the calibrated DCO at MCLK_HZ; the SAA1064 is a
+ * 	standard mode part.
+ * 	SCL/SDA sit on the USCI_B0 pins, so the hardware backend
+ * 	is used.  Boards wired to other P1 pins can switch to
+ * 	I2C_BITBANG and set I2C_BB_SDA/I2C_BB_SCL, but the
+ * 	bit-bang engine cannot reach standard mode: at 8 MHz it
+ * 	builds with I2C_SPEED up to 20000UL, or up to 40000UL
+ * 	with MCLK_HZ at 16 MHz (see I2C_BB_ISR_CYCLES in i2c.h).
+ * 	The SAA1064 works at any rate below its maximum.
+ ************************************************************/
+
+#ifndef I2C_CONFIG_H_
+#define I2C_CONFIG_H_
+
+#define I2C_BACKEND		I2C_USCI
+#define MCLK_HZ			8000000UL
+#define I2C_SPEED		I2C_STANDARD
+
+#endif /* I2C_CONFIG_H_ */
@@ -0,0 +1,15 @@
+/*************************************************************
+ * File:	keypad_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Keypad wiring for this lab.  deMUX select on
+ * 	ports 1.3 and 1.4 (keypad.h defaults).
+ * 	Keys map to SAA1064 segment codes.
+ ************************************************************/
+
+#ifndef KEYPAD_CONFIG_H_
+#define KEYPAD_CONFIG_H_
+
+#define KEYPAD_KEYMAP	KEYMAP_7SEG
+
+#endif /* KEYPAD_CONFIG_H_ */
@@ -0,0 +1,16 @@
+/*************************************************************
+ * File:	saa1064_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	SAA1064 settings for this lab.  ADR is tied
+ * 	to VCC (0x76 on the wire); dynamic mode, all digits on,
+ * 	12 mA segment current.
+ ************************************************************/
+
+#ifndef SAA1064_CONFIG_H_
+#define SAA1064_CONFIG_H_
+
+#define SAA1064_ADDR	0x3B
+#define SAA1064_CTRL	0x37
+
+#endif /* SAA1064_CONFIG_H_ */
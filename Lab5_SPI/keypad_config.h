@@ -0,0 +1,21 @@
+/*************************************************************
+ * File:	keypad_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Keypad wiring for this lab.  P1.4 is UCA0CLK,
+ * 	so the deMUX select moves to ports 1.3 and 1.5.
+ * 	Keys map to ASCII for the LCD.  Key events are posted to
+ * 	the scheduler.
+ ************************************************************/
+
+#ifndef KEYPAD_CONFIG_H_
+#define KEYPAD_CONFIG_H_
+
+#define KEYPAD_KEYMAP	KEYMAP_ASCII
+
+#define KEYPAD_MUX_LO	BIT3
+#define KEYPAD_MUX_HI	BIT5
+
+#define KEYPAD_EVENT	EV_KEY
+
+#endif /* KEYPAD_CONFIG_H_ */
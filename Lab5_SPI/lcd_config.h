@@ -0,0 +1,15 @@
+/*************************************************************
+ * File:	lcd_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	LCD wiring for this lab.  Slave reset on
+ * 	P1.5 (lcd.h default).  The bottom row is addressed from
+ * 	DDRAM 0x28, as this lab always has.
+ ************************************************************/
+
+#ifndef LCD_CONFIG_H_
+#define LCD_CONFIG_H_
+
+#define LCD_LINE2		0x28
+
+#endif /* LCD_CONFIG_H_ */
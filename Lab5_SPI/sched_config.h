@@ -0,0 +1,14 @@
+/*************************************************************
+ * File:	sched_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	Scheduler events for this lab.
+ ************************************************************/
+
+#ifndef SCHED_CONFIG_H_
+#define SCHED_CONFIG_H_
+
+#define EV_KEY			0		// keypad event queued
+#define EV_SPI			1		// SPI queue ran dry
+
+#endif /* SCHED_CONFIG_H_ */
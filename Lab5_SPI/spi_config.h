@@ -0,0 +1,23 @@
+/*************************************************************
+ * File:	spi_config.h
+ * Author:	Ross Moon
+ * Date:	10/17/2026
+ * Description:	SPI wiring and timing for this lab.  CS on
+ * 	P1.6, RS on P1.7 (spi.h defaults).  MCLK = SMCLK runs
+ * 	from the calibrated DCO at MCLK_HZ; the LCD clock is
+ * 	SMCLK / 4.  The waits are the ST7032 execution times at
+ * 	its slowest oscillator.  The queue running dry is posted
+ * 	to the scheduler.
+ ************************************************************/
+
+#ifndef SPI_CONFIG_H_
+#define SPI_CONFIG_H_
+
+#define MCLK_HZ				8000000UL
+#define SPI_BR				4
+#define SPI_WAIT_SHORT_NS	26300UL		// data and most instructions
+#define SPI_WAIT_LONG_NS	1080000UL	// clear, return home
+
+#define SPI_EVENT			EV_SPI
+
+#endif /* SPI_CONFIG_H_ */